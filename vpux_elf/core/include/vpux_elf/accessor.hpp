@@ -106,27 +106,59 @@ private:
 
 class DynamicBufferFactory : public BufferFactoryBase {
 public:
+    DynamicBufferFactory(std::shared_ptr<HostAllocator> hostAllocator = HostAllocator::getDefault())
+            : mHostAllocator(std::move(hostAllocator)) {
+        VPUX_ELF_THROW_UNLESS(mHostAllocator, RuntimeError, "Received nullptr HostAllocator");
+    }
+
     std::unique_ptr<ManagedBuffer> getAllocatedBuffer(BufferSpecs specs) {
-        return std::make_unique<DynamicBuffer>(specs);
+        return std::make_unique<DynamicBuffer>(specs, mHostAllocator);
+    }
+
+private:
+    std::shared_ptr<HostAllocator> mHostAllocator;
+};
+
+// Each factory owns a MonotonicHostAllocator, so an access manager default-constructing it (e.g.
+// FSAccessManager<HostArenaBufferFactory>) and the loader reading through it get a private host arena
+class HostArenaBufferFactory : public DynamicBufferFactory {
+public:
+    HostArenaBufferFactory(size_t blockSize = MonotonicHostAllocator::DEFAULT_BLOCK_SIZE)
+            : HostArenaBufferFactory(std::make_shared<MonotonicHostAllocator>(blockSize)) {
     }
+
+    const std::shared_ptr<MonotonicHostAllocator>& getHostArena() const {
+        return mHostArena;
+    }
+
+private:
+    HostArenaBufferFactory(std::shared_ptr<MonotonicHostAllocator> hostArena)
+            : DynamicBufferFactory(hostArena), mHostArena(std::move(hostArena)) {
+    }
+
+    std::shared_ptr<MonotonicHostAllocator> mHostArena;
 };
 
 class HybridBufferFactory : public BufferFactoryBase {
 public:
-    HybridBufferFactory(BufferManager* bufferManager): mBufferManager(bufferManager) {
+    HybridBufferFactory(BufferManager* bufferManager,
+                        std::shared_ptr<HostAllocator> hostAllocator = HostAllocator::getDefault())
+            : mBufferManager(bufferManager), mHostAllocator(std::move(hostAllocator)) {
         VPUX_ELF_THROW_UNLESS(mBufferManager, RuntimeError, "Received nullptr BufferManager");
+        VPUX_ELF_THROW_UNLESS(mHostAllocator, RuntimeError, "Received nullptr HostAllocator");
     }
 
     std::unique_ptr<ManagedBuffer> getAllocatedBuffer(BufferSpecs specs) {
         if (utils::hasNPUAccess(specs.procFlags)) {
             return std::make_unique<AllocatedDeviceBuffer>(mBufferManager, specs);
         } else {
-            return std::make_unique<DynamicBuffer>(specs);
+            return std::make_unique<DynamicBuffer>(specs, mHostAllocator);
         }
     }
 
 private:
     BufferManager* mBufferManager = nullptr;
+    std::shared_ptr<HostAllocator> mHostAllocator;
 };
 
 class DDRAccessManagerBase : public AccessManager {
@@ -138,8 +170,9 @@ public:
     void readExternal(size_t offset, ManagedBuffer& buffer) override {
         VPUX_ELF_THROW_WHEN((offset + buffer.getBufferSpecs().size) > mSize, AccessError, "Read request out of bounds");
 
-        auto devBuffer = buffer.getBuffer();
+        // the cpu_addr is valid only after locking
         auto lock = ElfBufferLockGuard(&buffer);
+        auto devBuffer = buffer.getBuffer();
         std::memcpy(devBuffer.cpu_addr(), mBlob + offset, devBuffer.size());
     }
 
@@ -14,6 +14,7 @@
 #include <vpux_elf/types/data_types.hpp>
 #include <vpux_elf/types/elf_header.hpp>
 #include <vpux_elf/types/elf_structs.hpp>
+#include <vpux_elf/types/program_header.hpp>
 #include <vpux_elf/types/section_header.hpp>
 #include <vpux_elf/types/vpu_extensions.hpp>
 #include <vpux_elf/utils/error.hpp>
@@ -73,14 +74,26 @@ public:
             // VPU_SHT_CMX_WORKSPACE - does not contain data in the binary file, so avoid reading
             if (!((mHeader->sh_type == SHT_NOBITS) || (mHeader->sh_type == VPU_SHT_CMX_METADATA) ||
                   mHeader->sh_type == VPU_SHT_CMX_WORKSPACE)) {
+                // the Reader can't tell relocation targets, so device buffers only get the hints of the header
+                auto placementHints = PLACEMENT_CPU_ONLY;
+                if (!cpuOnlyAccess && utils::hasNPUAccess(mHeader->sh_flags)) {
+                    placementHints = PLACEMENT_CPU_WRITE_AT_LOAD | (mHeader->sh_flags & SHF_WRITE
+                                                                            ? PLACEMENT_DEVICE_WRITTEN
+                                                                            : PLACEMENT_DEVICE_READ_ONLY);
+                }
                 buffer = mAccessManager->readInternal(
-                        mHeader->sh_offset,
-                        BufferSpecs(mHeader->sh_addralign, mHeader->sh_size, cpuOnlyAccess ? 0 : mHeader->sh_flags));
+                        mHeader->sh_offset, BufferSpecs(mHeader->sh_addralign, mHeader->sh_size,
+                                                        cpuOnlyAccess ? 0 : mHeader->sh_flags, placementHints));
             }
 
             return buffer;
         }
 
+        // Bytes held by the data buffer cached by getData
+        size_t getCachedDataSize() const {
+            return mDataBuffer ? mDataBuffer->getOwnedSize() : 0;
+        }
+
     private:
         AccessManager* mAccessManager = nullptr;
         const typename ElfTypes<B>::SectionHeader* mHeader = nullptr;
@@ -123,6 +136,28 @@ public:
             readBuffer = buildBufferFromMember(&mSectionNames[0], mSectionNames.size() * sizeof(mSectionNames[0]));
             mAccessManager->readExternal(secNamesSection.sh_offset, readBuffer);
         }
+
+        // program headers are optional, the Writer emits them only for blobs with load segments
+        if (mElfHeader.e_phnum) {
+            VPUX_ELF_THROW_UNLESS(sizeof(typename ElfTypes<B>::ProgramHeader) == mElfHeader.e_phentsize, HeaderError,
+                                  "Mismatch between expected and received program header size");
+            VPUX_ELF_THROW_UNLESS(mElfHeader.e_phoff >= sizeof(mElfHeader), HeaderError,
+                                  "Program header table overlaps ELF header");
+            VPUX_ELF_THROW_WHEN(mElfHeader.e_phnum == PN_XNUM, HeaderError, "Extended segments count is unsupported");
+
+            mProgramHeaders.resize(mElfHeader.e_phnum);
+            readBuffer =
+                    buildBufferFromMember(&mProgramHeaders[0], mProgramHeaders.size() * sizeof(mProgramHeaders[0]));
+            mAccessManager->readExternal(mElfHeader.e_phoff, readBuffer);
+
+            for (const auto& programHeader : mProgramHeaders) {
+                VPUX_ELF_THROW_WHEN(programHeader.p_filesz > programHeader.p_memsz, HeaderError,
+                                    "Segment file size exceeds its memory size");
+                VPUX_ELF_THROW_WHEN(programHeader.p_offset > mAccessManager->getSize() ||
+                                            programHeader.p_filesz > mAccessManager->getSize() - programHeader.p_offset,
+                                    HeaderError, "Segment exceeds buffer size");
+            }
+        }
     }
 
     const typename ElfTypes<B>::ELFHeader* getHeader() const {
@@ -153,12 +188,31 @@ public:
         return mSectionsCache.insert(std::make_pair(index, Section(mAccessManager, &secHeader, name))).first->second;
     }
 
+    size_t getSegmentsNum() const {
+        return mProgramHeaders.size();
+    }
+
+    const typename ElfTypes<B>::ProgramHeader* getSegment(size_t index) const {
+        VPUX_ELF_THROW_WHEN(index >= mProgramHeaders.size(), RangeError, "Segment index out of bounds");
+        return &mProgramHeaders[index];
+    }
+
+    // Bytes held by the data buffers cached by the sections
+    size_t getCachedDataSize() const {
+        size_t cachedDataSize = 0;
+        for (const auto& section : mSectionsCache) {
+            cachedDataSize += section.second.getCachedDataSize();
+        }
+        return cachedDataSize;
+    }
+
 private:
     BufferManager* mBufferManager;
     AccessManager* mAccessManager;
 
     typename ElfTypes<B>::ELFHeader mElfHeader;
     std::vector<typename ElfTypes<B>::SectionHeader> mSectionHeaders;
+    std::vector<typename ElfTypes<B>::ProgramHeader> mProgramHeaders;
     std::vector<char> mSectionNames;
 
     mutable std::unordered_map<size_t, Section> mSectionsCache;
@@ -9,6 +9,7 @@
 
 #include <vpux_elf/types/data_types.hpp>
 #include <vpux_elf/types/elf_header.hpp>
+#include <vpux_elf/types/program_header.hpp>
 #include <vpux_elf/types/relocation_entry.hpp>
 #include <vpux_elf/types/section_header.hpp>
 #include <vpux_elf/types/symbol_entry.hpp>
@@ -28,6 +29,7 @@ struct ElfTypes {
 template <>
 struct ElfTypes<ELF_Bitness::Elf32> {
     using ELFHeader = Elf32_Ehdr;
+    using ProgramHeader = Elf32_Phdr;
     using RelocationEntry = Elf32_Rel;
     using RelocationAEntry = Elf32_Rela;
     using SectionHeader = Elf32_Shdr;
@@ -37,6 +39,7 @@ struct ElfTypes<ELF_Bitness::Elf32> {
 template <>
 struct ElfTypes<ELF_Bitness::Elf64> {
     using ELFHeader = Elf64_Ehdr;
+    using ProgramHeader = Elf64_Phdr;
     using RelocationEntry = Elf64_Rel;
     using RelocationAEntry = Elf64_Rela;
     using SectionHeader = Elf64_Shdr;
@@ -184,6 +184,7 @@ constexpr Elf_Word VPU_SHT_CMX_METADATA   = 0x8aaaaaac;
 constexpr Elf_Word VPU_SHT_CMX_WORKSPACE  = 0x8aaaaaad;
 constexpr Elf_Word VPU_SHT_PERF_METRICS   = 0x8aaaaaae;
 constexpr Elf_Word VPU_SHT_PLATFORM_INFO  = 0x8aaaaaaf;
+constexpr Elf_Word VPU_SHT_RELA_PACKED    = 0x8aaaaab0;
 
 //
 // Section flags
@@ -193,10 +194,29 @@ constexpr Elf_Xword VPU_SHF_JIT             = 0x100000;
 constexpr Elf_Xword VPU_SHF_USERINPUT       = 0x200000;
 constexpr Elf_Xword VPU_SHF_USEROUTPUT      = 0x400000;
 constexpr Elf_Xword VPU_SHF_PROFOUTPUT      = 0x800000;
+// Set on relocation sections whose relocations patch the target section in non-decreasing offset order
+constexpr Elf_Xword VPU_SHF_RELA_SORTED     = 0x1000000;
 constexpr Elf_Xword VPU_SHF_PROC_DPU        = 0x10000000;
 constexpr Elf_Xword VPU_SHF_PROC_DMA        = 0x20000000;
 constexpr Elf_Xword VPU_SHF_PROC_SHAVE      = 0x40000000;
 
+//
+// Packed relocation entries
+//
+
+/// Entry of a VPU_SHT_RELA_PACKED section
+/// Describes r_count relocations of the same type against the same symbol (r_info), where the i-th relocation
+/// patches r_offset + i * r_stride using the addend r_addend + i * r_addend_stride
+/// sh_link and sh_info of the section have the same meaning as for SHT_RELA
+struct VPU_PackedRelocationAEntry {
+    Elf64_Addr r_offset;
+    Elf_Xword  r_info;
+    Elf_Sxword r_addend;
+    Elf_Sxword r_addend_stride;
+    Elf_Word   r_count;
+    Elf_Word   r_stride;
+};
+
 //
 // Special section indexes
 //
@@ -226,5 +246,8 @@ const Elf_Word VPU_SH_ADDR_ALIGN_FOR_VPU = 64;
 namespace elf_note {
 // Custom values for n_type field of SHT_NOTE section
 constexpr uint32_t NT_NPU_MPI_VERSION = 0xA000;
+// Records that the relocations against VPU_RT_SYMTAB were folded ahead of time into the sections they patch
+// Uses the VersionNote layout: n_desc[0] = arch kind, n_desc[1] = tile count, n_desc[2] = folded relocations count
+constexpr uint32_t NT_NPU_RT_SYMTAB_FOLDED = 0xA001;
 }
 }
@@ -0,0 +1,39 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace elf {
+namespace utils {
+
+using Sha256Digest = std::array<uint8_t, 32>;
+
+/**
+ * Incremental SHA-256 (FIPS 180-4), used to identify contents such as section data or whole blobs
+ */
+class Sha256 {
+public:
+    Sha256();
+
+    void update(const uint8_t* data, size_t size);
+    Sha256Digest finalize();
+
+private:
+    void processBlock(const uint8_t* block);
+
+    std::array<uint32_t, 8> mState;
+    std::array<uint8_t, 64> mBlock;
+    size_t mBlockSize = 0;
+    uint64_t mTotalSize = 0;
+};
+
+Sha256Digest sha256(const uint8_t* data, size_t size);
+
+}  // namespace utils
+}  // namespace elf
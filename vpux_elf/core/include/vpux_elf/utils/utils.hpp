@@ -19,6 +19,7 @@ bool isPowerOfTwo(size_t value);
 bool hasNPUAccess(Elf_Xword sectionFlags);
 bool isNetworkIO(Elf_Xword sectionFlags);
 bool hasMemoryFootprint(elf::Elf_Word sectionType);
+size_t getRelocationPatchSize(elf::Elf_Word relocationType);
 
 }  // namespace utils
 }  // namespace elf
@@ -18,6 +18,7 @@
 
 #include <vpux_elf/types/data_types.hpp>
 #include <vpux_elf/types/elf_header.hpp>
+#include <vpux_elf/types/program_header.hpp>
 #include <vpux_elf/types/section_header.hpp>
 
 #include <vpux_elf/utils/error.hpp>
@@ -38,6 +39,14 @@ public:
 
     void setSectionsStartAddr(uint8_t* elfBinary);
 
+    // When enabled (default disabled) the SHF_ALLOC sections, except network IO, are grouped by flags and
+    // relocation class (not relocated, relocated at load, relocated per inference) into PT_LOAD segments.
+    // The PROGBITS sections of a segment are laid out contiguously in the blob, followed in memory by its NOBITS
+    // sections, and sh_addr gives the position of each section inside the address range of its segment.
+    // Must be set before prepareWriter
+    bool getLoadSegments() const;
+    void setLoadSegments(bool loadSegments);
+
     writer::RelocationSection* addRelocationSection(const std::string& name = {});
     writer::SymbolSection* addSymbolSection(const std::string& name = {});
     writer::EmptySection* addEmptySection(const std::string& name = {});
@@ -57,6 +66,9 @@ private:
 
     elf::ELFHeader generateELFHeader() const;
 
+    // Sections of each segment, in creation order, see setLoadSegments
+    std::vector<std::vector<writer::Section*>> groupSegmentSections() const;
+
     static size_t writeRawBytesToStorageVector(uint8_t* storageVector, size_t storageSize, size_t storageOffset,
                                                const uint8_t* sourceData, size_t sourceByteCount);
 
@@ -96,6 +108,8 @@ private:
     writer::StringSection* m_symbolNames;
     std::vector<std::unique_ptr<writer::Section>> m_sections;
     std::vector<elf::SectionHeader> m_sectionHeaders;
+    bool m_loadSegments = false;
+    std::vector<elf::ProgramHeader> m_programHeaders;
 };
 
 }  // namespace elf
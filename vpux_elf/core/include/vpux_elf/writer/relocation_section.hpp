@@ -31,6 +31,11 @@ public:
     Relocation* addRelocationEntry();
     const std::vector<std::unique_ptr<Relocation>>& getRelocations() const;
 
+    // When enabled (default) relocations are serialized as a VPU_SHT_RELA_PACKED section
+    // if the packed encoding is smaller than the plain SHT_RELA one
+    bool isPackingEnabled() const;
+    void setPackingEnabled(bool packingEnabled);
+
 private:
     explicit RelocationSection(const std::string& name);
 
@@ -41,6 +46,7 @@ private:
     const Section* m_sectionToPatch = nullptr;
 
     std::vector<std::unique_ptr<Relocation>> m_relocations;
+    bool m_packingEnabled = true;
 
     friend Writer;
 };
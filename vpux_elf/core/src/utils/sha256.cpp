@@ -0,0 +1,133 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include <vpux_elf/utils/error.hpp>
+#include <vpux_elf/utils/sha256.hpp>
+
+namespace elf {
+namespace utils {
+
+namespace {
+
+constexpr std::array<uint32_t, 64> ROUND_CONSTANTS = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+uint32_t rotateRight(uint32_t value, uint32_t count) {
+    return (value >> count) | (value << (32 - count));
+}
+
+}  // namespace
+
+Sha256::Sha256()
+        : mState{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19} {
+}
+
+void Sha256::update(const uint8_t* data, size_t size) {
+    VPUX_ELF_THROW_WHEN(!data && size, ArgsError, "nullptr passed for data");
+    mTotalSize += size;
+
+    if (mBlockSize) {
+        const auto count = std::min(size, mBlock.size() - mBlockSize);
+        std::memcpy(mBlock.data() + mBlockSize, data, count);
+        mBlockSize += count;
+        data += count;
+        size -= count;
+        if (mBlockSize < mBlock.size()) {
+            return;
+        }
+        processBlock(mBlock.data());
+        mBlockSize = 0;
+    }
+
+    for (; size >= mBlock.size(); data += mBlock.size(), size -= mBlock.size()) {
+        processBlock(data);
+    }
+
+    if (size) {
+        std::memcpy(mBlock.data(), data, size);
+        mBlockSize = size;
+    }
+}
+
+Sha256Digest Sha256::finalize() {
+    const auto totalBits = mTotalSize * 8;
+
+    // 0x80 terminator, zero padding up to 56 bytes modulo 64, then the big-endian bit count
+    const uint8_t terminator = 0x80;
+    update(&terminator, 1);
+    const std::array<uint8_t, 64> zeros{};
+    update(zeros.data(), (mBlock.size() + 56 - mBlockSize) % mBlock.size());
+
+    std::array<uint8_t, 8> bitCount;
+    for (size_t byteIdx = 0; byteIdx < bitCount.size(); ++byteIdx) {
+        bitCount[byteIdx] = static_cast<uint8_t>(totalBits >> (56 - 8 * byteIdx));
+    }
+    update(bitCount.data(), bitCount.size());
+
+    Sha256Digest digest;
+    for (size_t wordIdx = 0; wordIdx < mState.size(); ++wordIdx) {
+        for (size_t byteIdx = 0; byteIdx < 4; ++byteIdx) {
+            digest[wordIdx * 4 + byteIdx] = static_cast<uint8_t>(mState[wordIdx] >> (24 - 8 * byteIdx));
+        }
+    }
+    return digest;
+}
+
+void Sha256::processBlock(const uint8_t* block) {
+    std::array<uint32_t, 64> schedule;
+    for (size_t wordIdx = 0; wordIdx < 16; ++wordIdx) {
+        schedule[wordIdx] = (uint32_t(block[wordIdx * 4]) << 24) | (uint32_t(block[wordIdx * 4 + 1]) << 16) |
+                            (uint32_t(block[wordIdx * 4 + 2]) << 8) | uint32_t(block[wordIdx * 4 + 3]);
+    }
+    for (size_t wordIdx = 16; wordIdx < schedule.size(); ++wordIdx) {
+        const auto s0 = rotateRight(schedule[wordIdx - 15], 7) ^ rotateRight(schedule[wordIdx - 15], 18) ^
+                        (schedule[wordIdx - 15] >> 3);
+        const auto s1 = rotateRight(schedule[wordIdx - 2], 17) ^ rotateRight(schedule[wordIdx - 2], 19) ^
+                        (schedule[wordIdx - 2] >> 10);
+        schedule[wordIdx] = schedule[wordIdx - 16] + s0 + schedule[wordIdx - 7] + s1;
+    }
+
+    auto state = mState;
+    for (size_t round = 0; round < schedule.size(); ++round) {
+        const auto s1 = rotateRight(state[4], 6) ^ rotateRight(state[4], 11) ^ rotateRight(state[4], 25);
+        const auto choice = (state[4] & state[5]) ^ (~state[4] & state[6]);
+        const auto temp1 = state[7] + s1 + choice + ROUND_CONSTANTS[round] + schedule[round];
+        const auto s0 = rotateRight(state[0], 2) ^ rotateRight(state[0], 13) ^ rotateRight(state[0], 22);
+        const auto majority = (state[0] & state[1]) ^ (state[0] & state[2]) ^ (state[1] & state[2]);
+        const auto temp2 = s0 + majority;
+
+        state[7] = state[6];
+        state[6] = state[5];
+        state[5] = state[4];
+        state[4] = state[3] + temp1;
+        state[3] = state[2];
+        state[2] = state[1];
+        state[1] = state[0];
+        state[0] = temp1 + temp2;
+    }
+
+    for (size_t wordIdx = 0; wordIdx < mState.size(); ++wordIdx) {
+        mState[wordIdx] += state[wordIdx];
+    }
+}
+
+Sha256Digest sha256(const uint8_t* data, size_t size) {
+    Sha256 hasher;
+    hasher.update(data, size);
+    return hasher.finalize();
+}
+
+}  // namespace utils
+}  // namespace elf
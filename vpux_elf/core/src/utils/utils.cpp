@@ -60,6 +60,48 @@ bool hasMemoryFootprint(elf::Elf_Word sectionType) {
     }
 }
 
+//
+// @brief returning the number of bytes of the target section modified by a relocation
+// @params relocation type
+// @return 0 for unknown relocation types
+//
+size_t getRelocationPatchSize(elf::Elf_Word relocationType) {
+    switch (relocationType) {
+    case elf::R_VPU_16_SUM:
+    case elf::R_VPU_32_BIT_OR_B21_B26_UNSET_HIGH_16:
+    case elf::R_VPU_32_BIT_OR_B21_B26_UNSET_LOW_16:
+        return sizeof(uint16_t);
+    case elf::R_VPU_32:
+    case elf::R_VPU_32_RTM:
+    case elf::R_VPU_32_SUM:
+    case elf::R_VPU_32_MULTICAST_BASE:
+    case elf::R_VPU_32_MULTICAST_BASE_SUB:
+    case elf::R_VPU_DISP28_MULTICAST_OFFSET:
+    case elf::R_VPU_DISP4_MULTICAST_OFFSET_CMP:
+    case elf::R_VPU_LO_21:
+    case elf::R_VPU_LO_21_SUM:
+    case elf::R_VPU_LO_21_MULTICAST_BASE:
+    case elf::R_VPU_16_LSB_21_RSHIFT_5:
+    case elf::R_VPU_LO_21_RSHIFT_4:
+    case elf::R_VPU_CMX_LOCAL_RSHIFT_5:
+    case elf::R_VPU_32_BIT_OR_B21_B26_UNSET:
+    case elf::R_VPU_16_LSB_21_RSHIFT_5_LSHIFT_16:
+    case elf::R_VPU_16_LSB_21_RSHIFT_5_LSHIFT_CUSTOM:
+        return sizeof(uint32_t);
+    case elf::R_VPU_64:
+    case elf::R_VPU_64_OR:
+    case elf::R_VPU_DISP40_RTM:
+    case elf::R_VPU_64_LSHIFT:
+    case elf::R_VPU_64_MULT:
+    case elf::R_VPU_64_MULT_SUB:
+    case elf::R_VPU_64_BIT_OR_B21_B26_UNSET:
+    case elf::R_VPU_HIGH_27_BIT_OR:
+        return sizeof(uint64_t);
+    default:
+        return 0;
+    }
+}
+
 }  // namespace utils
 
 }  // namespace elf
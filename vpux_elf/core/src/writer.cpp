@@ -8,12 +8,14 @@
 #include <cstddef>
 #include <cstdint>
 #include <utility>
+#include <vpux_elf/types/vpu_extensions.hpp>
 #include <vpux_elf/utils/error.hpp>
 #include <vpux_elf/utils/utils.hpp>
 #include <vpux_elf/writer.hpp>
 #include <vpux_elf/writer/empty_section.hpp>
 
 #include <algorithm>
+#include <map>
 #include <unordered_set>
 
 #include <iostream>
@@ -44,6 +46,11 @@ void Writer::prepareWriter() {
         section->setNameOffset(m_sectionHeaderNames->addString(section->getName()));
     }
 
+    // relocation sections know their target only once finalized
+    const auto segments = groupSegmentSections();
+    VPUX_ELF_THROW_WHEN(segments.size() >= PN_XNUM, RangeError, "Too many segments");
+    m_elfHeader.e_phnum = static_cast<Elf_Half>(segments.size());
+
     auto curOffset = static_cast<size_t>(m_elfHeader.e_ehsize);
     if (m_elfHeader.e_shnum) {
         m_elfHeader.e_shoff = utils::alignUp(curOffset, m_elfHeader.e_shentsize);
@@ -52,12 +59,85 @@ void Writer::prepareWriter() {
 
     curOffset += m_elfHeader.e_shnum * m_elfHeader.e_shentsize;
 
+    if (m_elfHeader.e_phnum) {
+        m_elfHeader.e_phentsize = sizeof(ProgramHeader);
+        m_elfHeader.e_phoff = utils::alignUp(curOffset, alignof(ProgramHeader));
+        curOffset = m_elfHeader.e_phoff + m_elfHeader.e_phnum * m_elfHeader.e_phentsize;
+    }
+
     m_dataOffset = static_cast<size_t>(curOffset);
     m_totalBinarySize = m_dataOffset;
 
+    // segments come first in the blob, each of them contiguous
+    // their address ranges start after the headers, so that sh_addr is never 0 for a section of a segment
+    m_programHeaders.clear();
+    m_programHeaders.reserve(segments.size());
+    std::unordered_set<const Section*> segmentSections;
+    auto segmentAddr = static_cast<Elf64_Addr>(m_dataOffset);
+    for (const auto& segment : segments) {
+        ProgramHeader programHeader{};
+        programHeader.p_type = PT_LOAD;
+        programHeader.p_flags = PF_R;
+        if (segment.front()->getFlags() & SHF_WRITE) {
+            programHeader.p_flags |= PF_W;
+        }
+        if (segment.front()->getFlags() & SHF_EXECINSTR) {
+            programHeader.p_flags |= PF_X;
+        }
+
+        programHeader.p_align = 1;
+        bool hasFileData = false;
+        for (const auto section : segment) {
+            programHeader.p_align = std::max<Elf_Xword>(programHeader.p_align, section->getAddrAlign());
+            hasFileData |= section->getType() == SHT_PROGBITS;
+        }
+
+        // the layout relative to the segment is the same in the blob and in memory
+        if (hasFileData) {
+            m_totalBinarySize = utils::alignUp(m_totalBinarySize, programHeader.p_align);
+            programHeader.p_offset = m_totalBinarySize;
+        }
+        segmentAddr = utils::alignUp(segmentAddr, programHeader.p_align);
+        programHeader.p_vaddr = segmentAddr;
+        programHeader.p_paddr = segmentAddr;
+
+        // PROGBITS sections first, NOBITS ones take no space in the blob
+        Elf_Xword segmentSize = 0;
+        for (const auto section : segment) {
+            if (section->getType() == SHT_PROGBITS) {
+                segmentSize = utils::alignUp(segmentSize, section->getAddrAlign());
+                section->m_header.sh_offset = programHeader.p_offset + segmentSize;
+                section->m_header.sh_addr = programHeader.p_vaddr + segmentSize;
+                segmentSize += section->getSize();
+            }
+        }
+        programHeader.p_filesz = segmentSize;
+        if (hasFileData) {
+            m_totalBinarySize = programHeader.p_offset + programHeader.p_filesz;
+        }
+
+        for (const auto section : segment) {
+            if (section->getType() == SHT_NOBITS) {
+                segmentSize = utils::alignUp(segmentSize, section->getAddrAlign());
+                section->m_header.sh_addr = programHeader.p_vaddr + segmentSize;
+                segmentSize += section->getSize();
+            }
+            segmentSections.insert(section);
+        }
+        programHeader.p_memsz = segmentSize;
+        segmentAddr = programHeader.p_vaddr + programHeader.p_memsz;
+
+        m_programHeaders.push_back(programHeader);
+    }
+
     m_sectionHeaders.reserve(m_elfHeader.e_shnum);
 
     for (auto& section : m_sections) {
+        if (segmentSections.count(section.get())) {
+            m_sectionHeaders.push_back(section->m_header);
+            continue;
+        }
+
         // account for alignment requirement of all sections, including those that don't occupy space in the blob
         // it's temporary solution to keep blobs of the same hash as before optimization and simplify validation
         // extra memory overhead is negligible, e.g. for Age&Gender blob of size 4.4MB we save around 3KB
@@ -105,6 +185,10 @@ void Writer::generateELF(uint8_t* data) {
     if (m_elfHeader.e_shoff) {
         m_dataOffset = writeContainerToStorageVector(data, size, m_dataOffset, m_sectionHeaders, 0, m_sectionHeaders.size());
     }
+
+    if (m_elfHeader.e_phoff) {
+        writeContainerToStorageVector(data, size, m_elfHeader.e_phoff, m_programHeaders, 0, m_programHeaders.size());
+    }
 }
 
 size_t Writer::getTotalSize() const {
@@ -118,6 +202,60 @@ void Writer::setSectionsStartAddr(uint8_t* elfBinaryAddr) {
     }
 }
 
+bool Writer::getLoadSegments() const {
+    return m_loadSegments;
+}
+
+void Writer::setLoadSegments(bool loadSegments) {
+    m_loadSegments = loadSegments;
+}
+
+std::vector<std::vector<Section*>> Writer::groupSegmentSections() const {
+    std::vector<std::vector<Section*>> segments;
+    if (!m_loadSegments) {
+        return segments;
+    }
+
+    // sections patched at load or per inference can't share memory with the ones that are never patched
+    enum RelocationClass { NOT_RELOCATED, RELOCATED_AT_LOAD, RELOCATED_PER_INFERENCE };
+    std::vector<RelocationClass> relocationClasses(m_sections.size(), NOT_RELOCATED);
+    for (const auto& section : m_sections) {
+        const auto& header = section->m_header;
+        if ((header.sh_type == SHT_RELA || header.sh_type == VPU_SHT_RELA_PACKED) &&
+            header.sh_info < m_sections.size()) {
+            auto& relocationClass = relocationClasses[header.sh_info];
+            relocationClass = std::max(
+                    relocationClass, header.sh_flags & VPU_SHF_JIT ? RELOCATED_PER_INFERENCE : RELOCATED_AT_LOAD);
+        }
+    }
+
+    std::map<std::pair<Elf_Xword /*section flags*/, RelocationClass>, size_t /*segment index*/> segmentIndexes;
+    for (const auto& section : m_sections) {
+        const auto& header = section->m_header;
+        // network IO sections are user buffers, never allocated by the loader
+        if (!(header.sh_flags & SHF_ALLOC) || utils::isNetworkIO(header.sh_flags) || !header.sh_size) {
+            continue;
+        }
+
+        // only the sections whose blob space doesn't change: PROGBITS with data and NOBITS without
+        const auto isNotEmptySection = dynamic_cast<EmptySection*>(section.get()) == nullptr;
+        const auto hasData = isNotEmptySection && section->getSize() != 0;
+        if ((header.sh_type != SHT_PROGBITS || !hasData) && (header.sh_type != SHT_NOBITS || hasData)) {
+            continue;
+        }
+
+        const auto segmentKey = std::make_pair(header.sh_flags, relocationClasses[section->getIndex()]);
+        auto segmentIndex = segmentIndexes.find(segmentKey);
+        if (segmentIndex == segmentIndexes.end()) {
+            segmentIndex = segmentIndexes.emplace(segmentKey, segments.size()).first;
+            segments.emplace_back();
+        }
+        segments[segmentIndex->second].push_back(section.get());
+    }
+
+    return segments;
+}
+
 Section* Writer::addSection(const std::string& name) {
     m_sections.push_back(std::unique_ptr<Section>(new Section(name)));
     m_sections.back()->setIndex(m_sections.size() - 1);
@@ -7,9 +7,88 @@
 
 #include <vpux_elf/writer/relocation_section.hpp>
 
+#include <vpux_elf/types/vpu_extensions.hpp>
+#include <vpux_elf/utils/utils.hpp>
+
+#include <algorithm>
+#include <limits>
+
 using namespace elf;
 using namespace elf::writer;
 
+namespace {
+
+// Merge consecutive relocations of the same type and symbol which patch equally spaced offsets with equally spaced
+// addends into runs. Only neighbouring entries are merged, so the order in which patches are applied is preserved
+std::vector<VPU_PackedRelocationAEntry> packRelocations(const std::vector<RelocationAEntry>& relocations) {
+    std::vector<VPU_PackedRelocationAEntry> runs;
+    runs.reserve(relocations.size());
+
+    for (const auto& relocation : relocations) {
+        if (!runs.empty()) {
+            auto& run = runs.back();
+            const auto lastOffset = run.r_offset + static_cast<Elf64_Addr>(run.r_count - 1) * run.r_stride;
+            const auto lastAddend = static_cast<uint64_t>(run.r_addend) +
+                                    static_cast<uint64_t>(run.r_count - 1) * static_cast<uint64_t>(run.r_addend_stride);
+
+            if (relocation.r_info == run.r_info && relocation.r_offset > lastOffset &&
+                relocation.r_offset - lastOffset <= std::numeric_limits<Elf_Word>::max() &&
+                run.r_count < std::numeric_limits<Elf_Word>::max()) {
+                const auto stride = static_cast<Elf_Word>(relocation.r_offset - lastOffset);
+                const auto addendStride =
+                        static_cast<Elf_Sxword>(static_cast<uint64_t>(relocation.r_addend) - lastAddend);
+
+                if (run.r_count == 1) {
+                    run.r_stride = stride;
+                    run.r_addend_stride = addendStride;
+                }
+
+                if (stride == run.r_stride && addendStride == run.r_addend_stride) {
+                    ++run.r_count;
+                    continue;
+                }
+            }
+        }
+
+        runs.push_back({relocation.r_offset, relocation.r_info, relocation.r_addend, 0, 1, 0});
+    }
+
+    return runs;
+}
+
+// Order the relocations by the offset they patch, so the loader walks the target section front to back
+// Relocations patching the same offset keep their relative order. Reordering is refused (returns false) when the
+// result could differ from applying the relocations in insertion order, i.e. when patches partially overlap or the
+// patch size of a relocation type is unknown
+bool sortRelocations(std::vector<RelocationAEntry>& relocations) {
+    std::vector<RelocationAEntry> sorted(relocations);
+    std::stable_sort(sorted.begin(), sorted.end(), [](const RelocationAEntry& lhs, const RelocationAEntry& rhs) {
+        return lhs.r_offset < rhs.r_offset;
+    });
+
+    Elf64_Addr groupOffset = 0;
+    Elf64_Addr groupEnd = 0;
+    for (const auto& relocation : sorted) {
+        const auto patchSize = utils::getRelocationPatchSize(elf64RType(relocation.r_info));
+        if (!patchSize) {
+            return false;
+        }
+
+        if (relocation.r_offset != groupOffset || groupEnd == 0) {
+            if (relocation.r_offset < groupEnd) {
+                return false;
+            }
+            groupOffset = relocation.r_offset;
+        }
+        groupEnd = std::max(groupEnd, relocation.r_offset + patchSize);
+    }
+
+    relocations.swap(sorted);
+    return true;
+}
+
+}  // namespace
+
 RelocationSection::RelocationSection(const std::string& name) : Section(name) {
     m_header.sh_type = SHT_RELA;
     m_header.sh_entsize = sizeof(RelocationAEntry);
@@ -49,6 +128,14 @@ const std::vector<std::unique_ptr<Relocation>>& RelocationSection::getRelocation
     return m_relocations;
 }
 
+bool RelocationSection::isPackingEnabled() const {
+    return m_packingEnabled;
+}
+
+void RelocationSection::setPackingEnabled(bool packingEnabled) {
+    m_packingEnabled = packingEnabled;
+}
+
 void RelocationSection::finalize() {
     m_header.sh_info = static_cast<Elf_Word>(m_sectionToPatch->getIndex());
     maskFlags(SHF_INFO_LINK);
@@ -56,14 +143,53 @@ void RelocationSection::finalize() {
         m_header.sh_link = static_cast<Elf_Word>(m_symTab->getIndex());
     }
 
+    std::vector<RelocationAEntry> relocationEntries;
+    relocationEntries.reserve(m_relocations.size());
     for (const auto& relocation : m_relocations) {
         auto relocationEntry = relocation->m_relocation;
         if (relocation->getSymbol()) {
             relocationEntry.r_info = elf64RInfo(static_cast<Elf_Word>(relocation->getSymbol()->getIndex()), relocation->getType());
         }
+        relocationEntries.push_back(relocationEntry);
+    }
+
+    std::vector<VPU_PackedRelocationAEntry> relocationRuns;
+    if (m_packingEnabled) {
+        relocationRuns = packRelocations(relocationEntries);
+    }
+
+    // Prefer the offset sorted encodings, unless packing the relocations in insertion order is strictly smaller
+    auto sortedEntries = relocationEntries;
+    if (sortRelocations(sortedEntries)) {
+        std::vector<VPU_PackedRelocationAEntry> sortedRuns;
+        if (m_packingEnabled) {
+            sortedRuns = packRelocations(sortedEntries);
+        }
+
+        const auto sortedSize = sortedRuns.empty() ? sortedEntries.size() * sizeof(RelocationAEntry)
+                                                   : std::min(sortedEntries.size() * sizeof(RelocationAEntry),
+                                                              sortedRuns.size() * sizeof(VPU_PackedRelocationAEntry));
+
+        if (relocationRuns.empty() || sortedSize <= relocationRuns.size() * sizeof(VPU_PackedRelocationAEntry)) {
+            relocationEntries.swap(sortedEntries);
+            relocationRuns.swap(sortedRuns);
+            maskFlags(VPU_SHF_RELA_SORTED);
+        }
+    }
 
-        m_data.insert(m_data.end(), reinterpret_cast<uint8_t*>(&relocationEntry),
-                      reinterpret_cast<uint8_t*>(&relocationEntry) + sizeof(relocationEntry));
+    const auto plainSize = relocationEntries.size() * sizeof(RelocationAEntry);
+    const auto packedSize = relocationRuns.size() * sizeof(VPU_PackedRelocationAEntry);
+
+    if (!relocationRuns.empty() && packedSize < plainSize) {
+        m_header.sh_type = VPU_SHT_RELA_PACKED;
+        m_header.sh_entsize = sizeof(VPU_PackedRelocationAEntry);
+        m_data.insert(m_data.end(), reinterpret_cast<uint8_t*>(relocationRuns.data()),
+                      reinterpret_cast<uint8_t*>(relocationRuns.data()) + packedSize);
+    } else {
+        m_header.sh_type = SHT_RELA;
+        m_header.sh_entsize = sizeof(RelocationAEntry);
+        m_data.insert(m_data.end(), reinterpret_cast<uint8_t*>(relocationEntries.data()),
+                      reinterpret_cast<uint8_t*>(relocationEntries.data()) + plainSize);
     }
 
     // set size of the section in header, so it gets accounted when writer calculates blob size before allocation
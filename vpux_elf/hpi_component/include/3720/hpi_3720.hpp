@@ -23,8 +23,8 @@ public:
 
 private:
     static constexpr uint32_t VERSION_MAJOR = 1;
-    static constexpr uint32_t VERSION_MINOR = 3;
-    static constexpr uint32_t VERSION_PATCH = 3;
+    static constexpr uint32_t VERSION_MINOR = 6;
+    static constexpr uint32_t VERSION_PATCH = 0;
 };
 
 }  // namespace elf
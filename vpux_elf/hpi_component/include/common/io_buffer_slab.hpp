@@ -0,0 +1,63 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <vpux_elf/types/data_types.hpp>
+#include <vpux_headers/buffer_manager.hpp>
+#include <vpux_headers/device_buffer.hpp>
+
+namespace elf {
+
+class HostParsedInference;
+
+struct IOBufferSlabOptions {
+    // also allocate the profiling buffers
+    bool profiling = false;
+    // minimum alignment of every buffer
+    size_t alignment = 64;
+    // procFlags of the slab allocation
+    Elf_Xword procFlags = 0;
+};
+
+/**
+ * Allocates the IO (and optionally profiling) buffers of requestsCount inference requests of a HostParsedInference
+ * in a single BufferManager allocation, instead of one allocation per buffer and request.
+ *
+ * The slab is laid out request by request: the inputs, outputs and profiling buffers of a request are contiguous.
+ * Buffers are sized from the IO descriptors of the HostParsedInference (getInputBuffers, getOutputBuffers,
+ * getProfBuffers) and aligned to at least IOBufferSlabOptions::alignment, raised to the element size of the tensor
+ * data type when the metadata describes it. The slab is locked for the lifetime of the IOBufferSlab, so that the host
+ * addresses of the request buffers stay valid, then unlocked and deallocated with it.
+ */
+class IOBufferSlab final {
+public:
+    // Ready to be passed to HostParsedInference::applyInputOutput
+    struct RequestBuffers {
+        std::vector<DeviceBuffer> inputs;
+        std::vector<DeviceBuffer> outputs;
+        std::vector<DeviceBuffer> profiling;
+    };
+
+    IOBufferSlab(BufferManager* bufferManager, HostParsedInference& hpi, size_t requestsCount,
+                 const IOBufferSlabOptions& options = IOBufferSlabOptions());
+    IOBufferSlab(const IOBufferSlab&) = delete;
+    IOBufferSlab& operator=(const IOBufferSlab&) = delete;
+    ~IOBufferSlab();
+
+    size_t getRequestsCount() const;
+    RequestBuffers& getRequestBuffers(size_t requestIdx);
+    DeviceBuffer getSlab() const;
+
+private:
+    BufferManager* mBufferManager;
+    DeviceBuffer mSlab;
+    std::vector<RequestBuffers> mRequests;
+};
+
+}  // namespace elf
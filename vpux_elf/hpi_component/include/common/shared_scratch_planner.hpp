@@ -0,0 +1,52 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <vpux_headers/buffer_specs.hpp>
+#include <vpux_headers/device_buffer.hpp>
+
+namespace elf {
+
+class HostParsedInference;
+
+/**
+ * Plans one DDR scratch region shared by several loaded HostParsedInferences which never execute concurrently.
+ *
+ * The inferences must have been created with HPIConfigs::inferencesMayBeRunInParallel = false and loaded with a
+ * BufferManager returning empty allocations for the SHARABLE_BUFFER_ENABLED scratch sections (their relocations are
+ * then deferred). Each inference lays its shared scratch sections out from the start of the region, so the region is
+ * sized to the largest requirement among the inferences instead of their sum.
+ *
+ * The region is allocated by the caller with getRegionSpecs() and handed to apply(), which re-points the scratch
+ * sections of every inference into it and applies their deferred relocations. The region must outlive the inferences
+ * and can be replaced by calling apply() again. As with updateSharedScratchBuffers, the BufferManager is handed the
+ * buffers pointing into the region for deallocation when the inferences are destroyed, and must ignore them.
+ */
+class SharedScratchPlanner final {
+public:
+    explicit SharedScratchPlanner(const std::vector<HostParsedInference*>& inferences);
+
+    // size: largest requirement, alignment: largest section alignment, procFlags: union of the section flags
+    BufferSpecs getRegionSpecs() const;
+    // Device memory the scratch sections would need if each inference had its own region
+    size_t getSeparateSize() const;
+    // Offsets of the shared scratch sections of an inference inside the region, in getSharedScratchBufferSpecs order
+    const std::vector<size_t>& getOffsets(size_t inferenceIdx) const;
+
+    void apply(DeviceBuffer region) const;
+
+private:
+    std::vector<HostParsedInference*> mInferences;
+    std::vector<std::vector<BufferSpecs>> mSectionSpecs;
+    std::vector<std::vector<size_t>> mOffsets;
+    BufferSpecs mRegionSpecs;
+    size_t mSeparateSize = 0;
+};
+
+}  // namespace elf
@@ -6,13 +6,18 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 #include <vpux_elf/accessor.hpp>
+#include <vpux_elf/utils/sha256.hpp>
 #include <vpux_elf/utils/version.hpp>
 #include <vpux_headers/buffer_manager.hpp>
+#include <vpux_headers/buffer_specs.hpp>
 #include <vpux_headers/device_buffer.hpp>
 #include <vpux_headers/managed_buffer.hpp>
+#include <vpux_headers/memory_usage.hpp>
 #include <vpux_headers/metadata.hpp>
+#include <vpux_headers/numa.hpp>
 #include <vpux_headers/platform.hpp>
 
 namespace elf {
@@ -25,6 +30,42 @@ class HostParsedInferenceCommon;
 struct HPIConfigs {
     elf::Version nnVersion;
     elf::platform::ArchKind archKind = elf::platform::ArchKind::UNKNOWN;
+    // sub-allocate the loader owned sections from one allocation per section flags class, see
+    // VPUXLoader::setArenaAllocations
+    bool arenaAllocations = false;
+    // sub-allocate the sections of each load segment of the blob from one allocation, see
+    // VPUXLoader::setSegmentAllocations
+    bool segmentAllocations = false;
+    // restore the writable sections from the AccessManager instead of keeping backups, see
+    // VPUXLoader::setBackupFreeReload. The AccessManager must then outlive the HostParsedInference and its copies
+    bool backupFreeReload = false;
+    // skip the profiling-only sections and patch the profiling pointers to a dummy address, see
+    // VPUXLoader::setProfilingElision
+    bool profilingElision = false;
+    // read, allocate and upload the sections concurrently, see VPUXLoader::setPipelinedLoad. The BufferManager must
+    // then be thread safe
+    bool pipelinedLoad = false;
+    // map the read-only sections byte-identical to the ones of other loaded models to the same device buffers, see
+    // VPUXLoader::setSharedSectionDeduplication
+    bool sharedSectionDeduplication = false;
+    // upload the large read-only sections in chunks, bounding the host memory used by the load, see
+    // VPUXLoader::setStreamingUpload
+    bool streamingUpload = false;
+    // the inferences of the HostParsedInference never run in parallel with other models, so its scratch sections may
+    // be shared with them (see SharedScratchPlanner), see VPUXLoader::setInferencesMayBeRunInParallel
+    bool inferencesMayBeRunInParallel = true;
+    // NUMA node the construction, the loads and the copies run on, e.g. the one the NPU is attached to, see
+    // VPUXLoader::setNumaNode
+    int numaNode = numa::NO_NUMA_NODE;
+    // directory of the on-disk cache of the state derived from the blob at construction, keyed by the blob contents,
+    // the arch and the library versions, see PrelinkCache. Empty to disable the cache
+    std::string prelinkCacheDirectory;
+    // digest identifying the blob, e.g. the SHA-256 of the blob computed when it was compiled or stored. Required with
+    // prelinkCacheDirectory, see VPUXLoader::VPUXLoader
+    utils::Sha256Digest prelinkBlobDigest{};
+    // upper bounds of the memory allocated by load() and by copies, checked before allocating, see
+    // VPUXLoader::setMemoryBudget
+    MemoryBudget memoryBudget;
 };
 
 class VersionsProvider final {
@@ -61,11 +102,28 @@ public:
     elf::Version getLibraryMIVersion() const;
     size_t getHPISize() const;
 
+    /**
+     * Memory held by the HostParsedInference: all of its loaders plus the parsed inference and entries buffers. The
+     * categories shared by the loaders are counted once
+     */
+    MemoryUsage getMemoryUsage() const;
+    MemoryUsage getPeakMemoryUsage() const;
+
     void applyInputOutput(std::vector<DeviceBuffer>& inputs, std::vector<DeviceBuffer>& outputs,
                           std::vector<DeviceBuffer>& profiling);
     void load();
 
     void updateSharedScratchBuffers(const std::vector<DeviceBuffer>& buffers);
+    std::vector<BufferSpecs> getSharedScratchBufferSpecs() const;
+    // see HPIConfigs::inferencesMayBeRunInParallel
+    bool getInferencesMayBeRunInParallel() const;
+
+    /**
+     * Ahead-of-time folding of the runtime symtab relocations of an ELF blob for a given arch and tile count
+     * See VPUXLoader::foldRuntimeSymTabRelocations. The folded blob can only be loaded for the same configuration
+     */
+    static std::vector<uint8_t> foldRuntimeSymTabRelocations(const uint8_t* elfBlob, size_t elfSize,
+                                                             elf::platform::ArchKind archKind, uint8_t tileCount);
 
 private:
     BufferManager* bufferManager;
@@ -77,12 +135,16 @@ private:
     std::shared_ptr<AllocatedDeviceBuffer> parsedInference;
     elf::HPIConfigs hpiCfg;
     std::shared_ptr<AllocatedDeviceBuffer> entries;
+    MemoryUsage peakMemoryUsage;
 
     // helpers
     void readMetadata();
     void readPlatformInfo();
     std::shared_ptr<ManagedBuffer> readPerfMetrics();
     elf::Version readVersioningInfo(uint32_t versionType) const;
+    bool readNote(uint32_t noteType, elf::elf_note::VersionNote& note) const;
+    void checkRuntimeSymTabFolding() const;
+    size_t getHPIBuffersSize(size_t tilesCount) const;
 };
 
 }  // namespace elf
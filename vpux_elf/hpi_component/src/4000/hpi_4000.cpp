@@ -43,8 +43,8 @@ const std::array<uint64_t, VPU_SCALABILITY_VALUES_PER_FREQ> byBWTicks({10UL, 12U
 namespace {
 
 constexpr uint32_t VPUX40XX_VERSION_MAJOR = 1;
-constexpr uint32_t VPUX40XX_VERSION_MINOR = 2;
-constexpr uint32_t VPUX40XX_VERSION_PATCH = 4;
+constexpr uint32_t VPUX40XX_VERSION_MINOR = 5;
+constexpr uint32_t VPUX40XX_VERSION_PATCH = 0;
 
 
 } // namespace
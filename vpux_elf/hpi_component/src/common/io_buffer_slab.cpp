@@ -0,0 +1,129 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#include <algorithm>
+
+#include <io_buffer_slab.hpp>
+#include <vpux_elf/utils/error.hpp>
+#include <vpux_elf/utils/log.hpp>
+#include <vpux_elf/utils/utils.hpp>
+#include <vpux_hpi.hpp>
+
+namespace elf {
+
+namespace {
+
+size_t getElementAlignment(DType dataType) {
+    switch (dataType) {
+    case DType_FP64:
+    case DType_U64:
+    case DType_I64:
+        return 8;
+    case DType_FP32:
+    case DType_U32:
+    case DType_I32:
+        return 4;
+    case DType_FP16:
+    case DType_BFP16:
+    case DType_U16:
+    case DType_I16:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+// Alignments of the buffers of one IO kind, the tensors are only used when they match the descriptors one to one
+std::vector<size_t> getAlignments(const std::vector<DeviceBuffer>& descriptors, const std::vector<TensorRef>& tensors,
+                                  size_t minAlignment) {
+    std::vector<size_t> alignments(descriptors.size(), minAlignment);
+    if (tensors.size() == descriptors.size()) {
+        for (size_t bufferIdx = 0; bufferIdx < descriptors.size(); ++bufferIdx) {
+            alignments[bufferIdx] = std::max(minAlignment, getElementAlignment(tensors[bufferIdx].data_type));
+        }
+    }
+    return alignments;
+}
+
+}  // namespace
+
+IOBufferSlab::IOBufferSlab(BufferManager* bufferManager, HostParsedInference& hpi, size_t requestsCount,
+                           const IOBufferSlabOptions& options)
+        : mBufferManager(bufferManager), mRequests(requestsCount) {
+    VPUX_ELF_THROW_UNLESS(mBufferManager, ArgsError, "nullptr BufferManager");
+    VPUX_ELF_THROW_UNLESS(requestsCount, ArgsError, "IOBufferSlab needs at least one request");
+    VPUX_ELF_THROW_UNLESS(utils::isPowerOfTwo(options.alignment), ArgsError, "IO alignment is not a power of 2");
+
+    const auto metadata = hpi.getMetadata();
+    const std::vector<DeviceBuffer> descriptors[] = {
+            hpi.getInputBuffers(), hpi.getOutputBuffers(),
+            options.profiling ? hpi.getProfBuffers() : std::vector<DeviceBuffer>()};
+    const std::vector<size_t> alignments[] = {
+            getAlignments(descriptors[0], metadata ? metadata->mNetInputs : std::vector<TensorRef>(),
+                          options.alignment),
+            getAlignments(descriptors[1], metadata ? metadata->mNetOutputs : std::vector<TensorRef>(),
+                          options.alignment),
+            getAlignments(descriptors[2], metadata ? metadata->mProfilingOutputs : std::vector<TensorRef>(),
+                          options.alignment)};
+
+    // offsets of the buffers inside a request, the requests are then laid out at a stride keeping every alignment
+    std::vector<size_t> offsets[3];
+    size_t requestSize = 0;
+    size_t slabAlignment = options.alignment;
+    for (size_t kind = 0; kind < 3; ++kind) {
+        for (size_t bufferIdx = 0; bufferIdx < descriptors[kind].size(); ++bufferIdx) {
+            const auto alignment = alignments[kind][bufferIdx];
+            offsets[kind].push_back(utils::alignUp(requestSize, alignment));
+            requestSize = offsets[kind].back() + descriptors[kind][bufferIdx].size();
+            slabAlignment = std::max(slabAlignment, alignment);
+        }
+    }
+    const auto requestStride = utils::alignUp(std::max<size_t>(requestSize, 1), slabAlignment);
+
+    mSlab = mBufferManager->allocate(BufferSpecs(slabAlignment, requestStride * requestsCount, options.procFlags));
+    // the host addresses of the request buffers are only valid while the slab is locked
+    try {
+        VPUX_ELF_THROW_WHEN(mSlab.size() < requestStride * requestsCount, AllocError, "IO slab allocation failed");
+        mBufferManager->lock(mSlab);
+    } catch (...) {
+        mBufferManager->deallocate(mSlab);
+        throw;
+    }
+    VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "IO slab of %zu bytes for %zu requests", requestStride * requestsCount,
+                 requestsCount);
+
+    for (size_t requestIdx = 0; requestIdx < requestsCount; ++requestIdx) {
+        std::vector<DeviceBuffer>* requestBuffers[] = {&mRequests[requestIdx].inputs, &mRequests[requestIdx].outputs,
+                                                       &mRequests[requestIdx].profiling};
+        for (size_t kind = 0; kind < 3; ++kind) {
+            requestBuffers[kind]->reserve(descriptors[kind].size());
+            for (size_t bufferIdx = 0; bufferIdx < descriptors[kind].size(); ++bufferIdx) {
+                const auto offset = requestIdx * requestStride + offsets[kind][bufferIdx];
+                requestBuffers[kind]->emplace_back(mSlab.cpu_addr() ? mSlab.cpu_addr() + offset : nullptr,
+                                                   mSlab.vpu_addr() + offset, descriptors[kind][bufferIdx].size());
+            }
+        }
+    }
+}
+
+IOBufferSlab::~IOBufferSlab() {
+    mBufferManager->unlock(mSlab);
+    mBufferManager->deallocate(mSlab);
+}
+
+size_t IOBufferSlab::getRequestsCount() const {
+    return mRequests.size();
+}
+
+IOBufferSlab::RequestBuffers& IOBufferSlab::getRequestBuffers(size_t requestIdx) {
+    VPUX_ELF_THROW_WHEN(requestIdx >= mRequests.size(), RangeError, "Request index out of range");
+    return mRequests[requestIdx];
+}
+
+DeviceBuffer IOBufferSlab::getSlab() const {
+    return mSlab;
+}
+
+}  // namespace elf
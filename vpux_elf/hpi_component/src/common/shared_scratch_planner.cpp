@@ -0,0 +1,87 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#include <algorithm>
+
+#include <shared_scratch_planner.hpp>
+#include <vpux_elf/utils/error.hpp>
+#include <vpux_elf/utils/log.hpp>
+#include <vpux_elf/utils/utils.hpp>
+#include <vpux_hpi.hpp>
+
+namespace elf {
+
+SharedScratchPlanner::SharedScratchPlanner(const std::vector<HostParsedInference*>& inferences)
+        : mInferences(inferences), mRegionSpecs(1, 0, 0) {
+    mSectionSpecs.reserve(mInferences.size());
+    mOffsets.reserve(mInferences.size());
+
+    for (auto inference : mInferences) {
+        VPUX_ELF_THROW_UNLESS(inference, ArgsError, "nullptr HostParsedInference");
+        // the scratch sections of inferences which may run in parallel with other models can't be shared
+        VPUX_ELF_THROW_WHEN(inference->getInferencesMayBeRunInParallel(), ArgsError,
+                            "HostParsedInference may be run in parallel, its scratch sections can't be shared");
+        mSectionSpecs.push_back(inference->getSharedScratchBufferSpecs());
+
+        // the scratch sections of an inference are live at the same time, so they are laid out one after the other
+        std::vector<size_t> offsets;
+        size_t inferenceSize = 0;
+        for (const auto& sectionSpecs : mSectionSpecs.back()) {
+            const auto alignment = std::max<size_t>(sectionSpecs.alignment, 1);
+            VPUX_ELF_THROW_UNLESS(utils::isPowerOfTwo(alignment), ArgsError,
+                                  "Scratch section alignment is not a power of 2");
+            const auto offset = utils::alignUp(inferenceSize, alignment);
+            offsets.push_back(offset);
+            inferenceSize = offset + sectionSpecs.size;
+
+            mRegionSpecs.alignment = std::max<uint64_t>(mRegionSpecs.alignment, alignment);
+            mRegionSpecs.procFlags |= sectionSpecs.procFlags & ~SHARABLE_BUFFER_ENABLED;
+        }
+
+        mOffsets.push_back(std::move(offsets));
+        mRegionSpecs.size = std::max<uint64_t>(mRegionSpecs.size, inferenceSize);
+        mSeparateSize += inferenceSize;
+    }
+
+    VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "Shared scratch region of %llu bytes for %zu inferences instead of %zu",
+                 static_cast<unsigned long long>(mRegionSpecs.size), mInferences.size(), mSeparateSize);
+}
+
+BufferSpecs SharedScratchPlanner::getRegionSpecs() const {
+    return mRegionSpecs;
+}
+
+size_t SharedScratchPlanner::getSeparateSize() const {
+    return mSeparateSize;
+}
+
+const std::vector<size_t>& SharedScratchPlanner::getOffsets(size_t inferenceIdx) const {
+    VPUX_ELF_THROW_WHEN(inferenceIdx >= mOffsets.size(), RangeError, "Inference index out of range");
+    return mOffsets[inferenceIdx];
+}
+
+void SharedScratchPlanner::apply(DeviceBuffer region) const {
+    VPUX_ELF_THROW_WHEN(region.size() < mRegionSpecs.size, ArgsError, "Shared scratch region smaller than planned");
+    VPUX_ELF_THROW_WHEN(region.vpu_addr() % mRegionSpecs.alignment, ArgsError,
+                        "Shared scratch region not aligned as planned");
+
+    for (size_t inferenceIdx = 0; inferenceIdx < mInferences.size(); ++inferenceIdx) {
+        const auto& sectionSpecs = mSectionSpecs[inferenceIdx];
+        if (sectionSpecs.empty()) {
+            continue;
+        }
+
+        std::vector<DeviceBuffer> buffers;
+        buffers.reserve(sectionSpecs.size());
+        for (size_t sectionIdx = 0; sectionIdx < sectionSpecs.size(); ++sectionIdx) {
+            const auto offset = mOffsets[inferenceIdx][sectionIdx];
+            buffers.emplace_back(region.cpu_addr() ? region.cpu_addr() + offset : nullptr, region.vpu_addr() + offset,
+                                 sectionSpecs[sectionIdx].size);
+        }
+        mInferences[inferenceIdx]->updateSharedScratchBuffers(buffers);
+    }
+}
+
+}  // namespace elf
@@ -99,23 +99,44 @@ void HostParsedInference::readPlatformInfo() {
     platformInfo = elf::platform::PlatformInfoSerialization::deserialize(platformInfoBufferPtr, platformInfoBufferSize);
 }
 
-elf::Version HostParsedInference::readVersioningInfo(uint32_t versionType) const {
+bool HostParsedInference::readNote(uint32_t noteType, elf::elf_note::VersionNote& note) const {
     const auto& noteSections = loaders.front()->getSectionsOfType(elf::SHT_NOTE);
     for (auto section : noteSections) {
         VPUX_ELF_THROW_UNLESS(section->getBuffer().size() == sizeof(elf::elf_note::VersionNote), SectionError,
                               "Wrong Versioning Note size");
 
         auto sectionLock = ElfBufferLockGuard(section.get());
-        elf::elf_note::VersionNote elfABIVersionNote{};
-        std::memcpy(&elfABIVersionNote, section->getBuffer().cpu_addr(), sizeof(elf::elf_note::VersionNote));
-        if (elfABIVersionNote.n_type == versionType) {
-            return elf::Version(elfABIVersionNote);
+        std::memcpy(&note, section->getBuffer().cpu_addr(), sizeof(elf::elf_note::VersionNote));
+        if (note.n_type == noteType) {
+            return true;
         }
     }
+    return false;
+}
+
+elf::Version HostParsedInference::readVersioningInfo(uint32_t versionType) const {
+    elf::elf_note::VersionNote elfABIVersionNote{};
+    if (readNote(versionType, elfABIVersionNote)) {
+        return elf::Version(elfABIVersionNote);
+    }
     VPUX_ELF_LOG(LogLevel::LOG_ERROR, "Could not retrieve versioning info of type %x", versionType);
     VPUX_ELF_THROW(RangeError, "Requested Versioning information was not found");
 }
 
+void HostParsedInference::checkRuntimeSymTabFolding() const {
+    elf::elf_note::VersionNote foldingNote{};
+    if (!readNote(elf::elf_note::NT_NPU_RT_SYMTAB_FOLDED, foldingNote)) {
+        return;
+    }
+
+    // runtime symbols were baked into the sections, so they have to be the ones this HPI would provide
+    auto foldedArchKind = foldingNote.n_desc[0];
+    auto foldedTileCount = foldingNote.n_desc[1];
+    VPUX_ELF_THROW_UNLESS(foldedArchKind == static_cast<uint32_t>(platformInfo->mArchKind) &&
+                                  foldedTileCount == metadata->mResourceRequirements.nn_slice_count_,
+                          ArgsError, "Runtime symtab relocations were folded for a different arch or tile count");
+}
+
 elf::Version HostParsedInference::getElfABIVersion() const {
     return readVersioningInfo(elf::elf_note::NT_GNU_ABI_TAG);
 }
@@ -136,10 +157,64 @@ size_t HostParsedInference::getHPISize() const {
     return getArchSpecificHPI(hpiCfg.archKind)->getParsedInferenceBufferSpecs().size;
 }
 
+size_t HostParsedInference::getHPIBuffersSize(size_t tilesCount) const {
+    auto archSpecificHpi = getArchSpecificHPI(platformInfo->mArchKind);
+    auto hpiBuffersSize = archSpecificHpi->getParsedInferenceBufferSpecs().size;
+    if (platformInfo->mArchKind == elf::platform::ArchKind::VPUX37XX &&
+        metadata->mResourceRequirements.nn_slice_count_ < archSpecificHpi->getArchTilesCount()) {
+        hpiBuffersSize += archSpecificHpi->getEntryBufferSpecs(tilesCount).size;
+    }
+    return hpiBuffersSize;
+}
+
+MemoryUsage HostParsedInference::getMemoryUsage() const {
+    MemoryUsage usage;
+    for (size_t idx = 0; idx < loaders.size(); ++idx) {
+        // the loaders of the other tiles share the sections of the first one
+        usage += loaders[idx]->getMemoryUsage(idx == 0);
+    }
+
+    for (const auto& hpiBuffer : {parsedInference, entries}) {
+        if (hpiBuffer) {
+            usage.deviceBytes += hpiBuffer->getOwnedSize();
+        }
+    }
+    return usage;
+}
+
+MemoryUsage HostParsedInference::getPeakMemoryUsage() const {
+    return peakMemoryUsage;
+}
+
 HostParsedInference::HostParsedInference(BufferManager* bufferMgr, AccessManager* accessMgr, elf::HPIConfigs hpiConfigs)
         : bufferManager(bufferMgr), accessManager(accessMgr), hpiCfg(hpiConfigs) {
+    ScopedNumaAffinity numaAffinity(hpiConfigs.numaNode);
+
     // create the loader object to cache sections
-    loaders.emplace_back(std::make_unique<VPUXLoader>(accessMgr, bufferMgr));
+    if (hpiConfigs.prelinkCacheDirectory.empty()) {
+        loaders.emplace_back(std::make_unique<VPUXLoader>(accessMgr, bufferMgr));
+    } else {
+        const auto libraryELFVersion = getLibraryELFVersion();
+        const auto libraryMIVersion = getLibraryMIVersion();
+        std::stringstream prelinkContext;
+        prelinkContext << elf::platform::stringifyArchKind(hpiConfigs.archKind) << " ELF "
+                       << libraryELFVersion.getMajor() << "." << libraryELFVersion.getMinor() << "."
+                       << libraryELFVersion.getPatch() << " MI " << libraryMIVersion.getMajor() << "."
+                       << libraryMIVersion.getMinor() << "." << libraryMIVersion.getPatch();
+        const PrelinkCache prelinkCache(hpiConfigs.prelinkCacheDirectory, prelinkContext.str());
+        loaders.emplace_back(
+                std::make_unique<VPUXLoader>(accessMgr, bufferMgr, &prelinkCache, hpiConfigs.prelinkBlobDigest));
+    }
+    loaders.front()->setArenaAllocations(hpiConfigs.arenaAllocations);
+    loaders.front()->setSegmentAllocations(hpiConfigs.segmentAllocations);
+    loaders.front()->setBackupFreeReload(hpiConfigs.backupFreeReload);
+    loaders.front()->setProfilingElision(hpiConfigs.profilingElision);
+    loaders.front()->setPipelinedLoad(hpiConfigs.pipelinedLoad);
+    loaders.front()->setSharedSectionDeduplication(hpiConfigs.sharedSectionDeduplication);
+    loaders.front()->setStreamingUpload(hpiConfigs.streamingUpload);
+    loaders.front()->setInferencesMayBeRunInParallel(hpiConfigs.inferencesMayBeRunInParallel);
+    loaders.front()->setNumaNode(hpiConfigs.numaNode);
+    loaders.front()->setMemoryBudget(hpiConfigs.memoryBudget);
 
     auto& expectedArch = hpiConfigs.archKind;
     auto archSpecificHpi = getArchSpecificHPI(expectedArch);
@@ -191,13 +266,22 @@ HostParsedInference::HostParsedInference(BufferManager* bufferMgr, AccessManager
 
 void HostParsedInference::load() {
     auto archSpecificHpi = getArchSpecificHPI(platformInfo->mArchKind);
+    checkRuntimeSymTabFolding();
 
     const auto symbolSectionTypes = archSpecificHpi->getSymbolSectionTypes();
     auto symTabOverrideMode = archSpecificHpi->getSymbolSectionTypes().size() == 0 ? false : true;
 
+    const bool loaderPerTile = platformInfo->mArchKind == elf::platform::ArchKind::VPUX37XX &&
+                               metadata->mResourceRequirements.nn_slice_count_ < archSpecificHpi->getArchTilesCount();
+
+    // fail before allocating anything: the loaders of the other tiles are copies of the first one
+    auto plannedUsage = loaders.front()->estimateLoadMemoryUsage(symTabOverrideMode);
+    const size_t loadersCount = loaderPerTile ? archSpecificHpi->getArchTilesCount() : 1;
+    plannedUsage.deviceBytes = plannedUsage.deviceBytes * loadersCount + getHPIBuffersSize(loadersCount);
+    hpiCfg.memoryBudget.check(plannedUsage, "HostParsedInference load");
+
     std::vector<uint64_t> entriesVct;
-    if (platformInfo->mArchKind == elf::platform::ArchKind::VPUX37XX &&
-        metadata->mResourceRequirements.nn_slice_count_ < archSpecificHpi->getArchTilesCount()) {
+    if (loaderPerTile) {
         entries = std::make_shared<AllocatedDeviceBuffer>(
                 bufferManager, archSpecificHpi->getEntryBufferSpecs(archSpecificHpi->getArchTilesCount()));
 
@@ -233,15 +317,14 @@ void HostParsedInference::load() {
 
     parsedInference =
             std::make_shared<AllocatedDeviceBuffer>(bufferManager, archSpecificHpi->getParsedInferenceBufferSpecs());
-    auto parsedInferenceLock = ElfBufferLockGuard(parsedInference.get());
+    perfMetrics = readPerfMetrics();
+    auto hpiBuffersLock = ElfBufferBatchLockGuard({parsedInference.get(), perfMetrics.get()});
 
     auto parsedInferenceBuffer = parsedInference->getBuffer();
-    perfMetrics = readPerfMetrics();
-    auto perfMetricsLock = ElfBufferLockGuard(perfMetrics.get());
     auto perfMetricsPtr = perfMetrics ? reinterpret_cast<uint64_t*>(perfMetrics->getBuffer().cpu_addr()) : nullptr;
     archSpecificHpi->setHostParsedInference(parsedInferenceBuffer, entriesVct, metadata->mResourceRequirements,
                                             perfMetricsPtr);
-
+    peakMemoryUsage.updatePeak(getMemoryUsage());
 }
 
 HostParsedInference::HostParsedInference(const HostParsedInference& other)
@@ -249,7 +332,15 @@ HostParsedInference::HostParsedInference(const HostParsedInference& other)
           accessManager(other.accessManager),
           metadata(other.metadata),
           platformInfo(other.platformInfo),
-          perfMetrics(other.perfMetrics) {
+          perfMetrics(other.perfMetrics),
+          hpiCfg(other.hpiCfg) {
+    MemoryUsage plannedUsage;
+    for (const auto& loader : other.loaders) {
+        plannedUsage.deviceBytes += loader->getMemoryUsage(false).deviceBytes;
+    }
+    plannedUsage.deviceBytes += other.getHPIBuffersSize(other.loaders.size());
+    hpiCfg.memoryBudget.check(plannedUsage, "HostParsedInference copy");
+
     auto archSpecificHpi = getArchSpecificHPI(platformInfo->mArchKind);
     // Use clone semantics here by copy-constructing the loader object
     loaders.reserve(other.loaders.size());
@@ -281,13 +372,13 @@ HostParsedInference::HostParsedInference(const HostParsedInference& other)
     // Every new loader object means a new parsedInference struct as well
     parsedInference =
             std::make_shared<AllocatedDeviceBuffer>(bufferManager, archSpecificHpi->getParsedInferenceBufferSpecs());
-    auto parsedInferenceLock = ElfBufferLockGuard(parsedInference.get());
+    auto hpiBuffersLock = ElfBufferBatchLockGuard({parsedInference.get(), perfMetrics.get()});
 
     auto parsedInferenceBuffer = parsedInference->getBuffer();
-    auto perfMetricsLock = ElfBufferLockGuard(perfMetrics.get());
     auto perfMetricsPtr = perfMetrics ? reinterpret_cast<uint64_t*>(perfMetrics->getBuffer().cpu_addr()) : nullptr;
     archSpecificHpi->setHostParsedInference(parsedInferenceBuffer, entriesVct, metadata->mResourceRequirements,
                                             perfMetricsPtr);
+    peakMemoryUsage.updatePeak(getMemoryUsage());
 };
 
 HostParsedInference::HostParsedInference(HostParsedInference&& other)
@@ -298,7 +389,9 @@ HostParsedInference::HostParsedInference(HostParsedInference&& other)
           perfMetrics(other.perfMetrics),
           loaders(std::move(other.loaders)),
           parsedInference(other.parsedInference),
-          entries(other.entries) {
+          hpiCfg(other.hpiCfg),
+          entries(other.entries),
+          peakMemoryUsage(other.peakMemoryUsage) {
 }
 
 HostParsedInference::~HostParsedInference() {
@@ -309,11 +402,19 @@ HostParsedInference& HostParsedInference::operator=(const HostParsedInference& r
         return *this;
     }
 
+    MemoryUsage plannedUsage;
+    for (const auto& loader : rhs.loaders) {
+        plannedUsage.deviceBytes += loader->getMemoryUsage(false).deviceBytes;
+    }
+    plannedUsage.deviceBytes += rhs.getHPIBuffersSize(rhs.loaders.size());
+    rhs.hpiCfg.memoryBudget.check(plannedUsage, "HostParsedInference copy");
+
     bufferManager = rhs.bufferManager;
     accessManager = rhs.accessManager;
     metadata = rhs.metadata;
     platformInfo = rhs.platformInfo;
     perfMetrics = rhs.perfMetrics;
+    hpiCfg = rhs.hpiCfg;
 
     auto archSpecificHpi = getArchSpecificHPI(platformInfo->mArchKind);
     // Use clone semantics here by copy-constructing the loader object
@@ -345,13 +446,13 @@ HostParsedInference& HostParsedInference::operator=(const HostParsedInference& r
     // Every new loader object means a new parsedInference struct as well
     parsedInference =
             std::make_shared<AllocatedDeviceBuffer>(bufferManager, archSpecificHpi->getParsedInferenceBufferSpecs());
-    auto parsedInferenceLock = ElfBufferLockGuard(parsedInference.get());
+    auto hpiBuffersLock = ElfBufferBatchLockGuard({parsedInference.get(), perfMetrics.get()});
 
     auto parsedInferenceBuffer = parsedInference->getBuffer();
-    auto perfMetricsLock = ElfBufferLockGuard(perfMetrics.get());
     auto perfMetricsPtr = perfMetrics ? reinterpret_cast<uint64_t*>(perfMetrics->getBuffer().cpu_addr()) : nullptr;
     archSpecificHpi->setHostParsedInference(parsedInferenceBuffer, entriesVct, metadata->mResourceRequirements,
                                             perfMetricsPtr);
+    peakMemoryUsage.updatePeak(getMemoryUsage());
 
     return *this;
 }
@@ -367,11 +468,27 @@ HostParsedInference& HostParsedInference::operator=(HostParsedInference&& rhs) {
     perfMetrics = rhs.perfMetrics;
     loaders = std::move(rhs.loaders);
     parsedInference = rhs.parsedInference;
+    hpiCfg = rhs.hpiCfg;
     entries = rhs.entries;
+    peakMemoryUsage = rhs.peakMemoryUsage;
 
     return *this;
 }
 
+std::vector<uint8_t> HostParsedInference::foldRuntimeSymTabRelocations(const uint8_t* elfBlob, size_t elfSize,
+                                                                       elf::platform::ArchKind archKind,
+                                                                       uint8_t tileCount) {
+    auto archSpecificHpi = getArchSpecificHPI(archKind);
+
+    // NPU3720 inferences using fewer tiles than available are loaded once per tile, each with its own runtime symbols
+    VPUX_ELF_THROW_WHEN(archKind == elf::platform::ArchKind::VPUX37XX &&
+                                tileCount < archSpecificHpi->getArchTilesCount(),
+                        ArgsError, "Runtime symtab relocations can't be folded for a partial tile NPU3720 inference");
+
+    return VPUXLoader::foldRuntimeSymTabRelocations(elfBlob, elfSize, archSpecificHpi->getSymbolTable(tileCount),
+                                                    archKind, tileCount);
+}
+
 DeviceBuffer HostParsedInference::getParsedInference() const {
     return parsedInference->getBuffer();
 }
@@ -426,4 +543,12 @@ void HostParsedInference::updateSharedScratchBuffers(const std::vector<DeviceBuf
     loader->updateSharedScratchBuffers(buffers);
 }
 
+std::vector<BufferSpecs> HostParsedInference::getSharedScratchBufferSpecs() const {
+    return loaders.front()->getSharedScratchBufferSpecs();
+}
+
+bool HostParsedInference::getInferencesMayBeRunInParallel() const {
+    return loaders.front()->getInferencesMayBeRunInParallel();
+}
+
 }  // namespace elf
@@ -5,13 +5,24 @@
 
 #pragma once
 
+#include <cstring>
 #include <memory>
+#include <vector>
 #include <vpux_elf/utils/error.hpp>
 #include <vpux_headers/buffer_specs.hpp>
 #include <vpux_headers/device_buffer.hpp>
 
 namespace elf {
 
+/// @brief Single element of a BufferManager::copyv request: copy count bytes from the host address from to the
+/// DeviceBuffer to, starting at offset (non-zero for the views sub-allocated from a single DeviceBuffer)
+struct BufferCopy {
+    DeviceBuffer* to = nullptr;
+    const uint8_t* from = nullptr;
+    size_t count = 0;
+    size_t offset = 0;
+};
+
 class BufferManager {
 public:
     virtual DeviceBuffer allocate(const BufferSpecs& buffSpecs) = 0;
@@ -35,7 +46,51 @@ public:
     /// @brief This API releases a DeviceBuffer that was previously locked by a lock call.
     /// @param devAddress - DeviceBuffer reference
     virtual void unlock(DeviceBuffer& devAddress) = 0;
+    /// @brief Locks several DeviceBuffers at once, with the same semantics as a lock call for each of them.
+    /// The loader locks the whole working set of a phase (load, clone, relocation) through this API, so
+    /// implementations able to map many buffers with a single call should override it. Defaults to one lock call per
+    /// DeviceBuffer.
+    /// @param devAddresses - DeviceBuffers to lock
+    virtual void lockMany(const std::vector<DeviceBuffer*>& devAddresses) {
+        for (auto devAddress : devAddresses) {
+            lock(*devAddress);
+        }
+    }
+    /// @brief Releases several DeviceBuffers previously locked by lock or lockMany calls.
+    /// Defaults to one unlock call per DeviceBuffer.
+    /// @param devAddresses - DeviceBuffers to unlock
+    virtual void unlockMany(const std::vector<DeviceBuffer*>& devAddresses) {
+        for (auto devAddress : devAddresses) {
+            unlock(*devAddress);
+        }
+    }
     virtual size_t copy(DeviceBuffer& to, const uint8_t* from, size_t count) = 0;
+    /// @brief Scatter-gather copy, with the same semantics as a copy call for each element of the list.
+    /// The loader submits all the section uploads of a load or reload through this API, so implementations able to
+    /// chain many transfers in a single submission (e.g. a DMA chain on discrete memory devices) should override it.
+    /// Defaults to one copy call per element (copyAt for the elements with an offset), in order.
+    /// @param copies - list of {destination, source, size, offset} copies
+    /// @return total number of bytes copied
+    virtual size_t copyv(const std::vector<BufferCopy>& copies) {
+        size_t copied = 0;
+        for (const auto& bufferCopy : copies) {
+            copied += bufferCopy.offset ? copyAt(*bufferCopy.to, bufferCopy.offset, bufferCopy.from, bufferCopy.count)
+                                        : copy(*bufferCopy.to, bufferCopy.from, bufferCopy.count);
+        }
+        return copied;
+    }
+    /// @brief Copies count bytes from the host address from to the DeviceBuffer to, starting at offset.
+    /// The loader streams large sections through this API chunk by chunk, with the DeviceBuffer locked. Defaults to a
+    /// memcpy through the cpu_addr of the locked DeviceBuffer.
+    /// @param to - locked destination DeviceBuffer
+    /// @param offset - offset of the copy inside the DeviceBuffer
+    /// @return number of bytes copied
+    virtual size_t copyAt(DeviceBuffer& to, size_t offset, const uint8_t* from, size_t count) {
+        VPUX_ELF_THROW_WHEN(offset > to.size() || count > to.size() - offset, RangeError,
+                            "Copy outside of the DeviceBuffer");
+        std::memcpy(to.cpu_addr() + offset, from, count);
+        return count;
+    }
     virtual ~BufferManager() = default;
 };
 
@@ -12,15 +12,37 @@ namespace elf {
 
 constexpr Elf_Xword SHARABLE_BUFFER_ENABLED = uint64_t{1} << sizeof(uint32_t) * CHAR_BIT;
 
+/**
+ * Placement hints derived by the loader, letting a BufferManager pick the mapping (cached vs write-combined) and the
+ * memory pool of a buffer. The engines accessing the buffer are given by the VPU_SHF_PROC_* bits of procFlags.
+ * Hints never change the semantics of a buffer, a BufferManager may ignore them.
+ */
+using PlacementHints = uint32_t;
+constexpr PlacementHints PLACEMENT_NONE = 0;
+// the device only reads the buffer (e.g. weights, kernels)
+constexpr PlacementHints PLACEMENT_DEVICE_READ_ONLY = 1 << 0;
+// the device writes the buffer during inferences (e.g. scratch, descriptors updated by the runtime)
+constexpr PlacementHints PLACEMENT_DEVICE_WRITTEN = 1 << 1;
+// the CPU uploads the contents once, at load or copy time, without reading them back: write-combining friendly
+constexpr PlacementHints PLACEMENT_CPU_WRITE_AT_LOAD = 1 << 2;
+// the CPU patches the buffer with relocations at load or copy time (read-modify-write)
+constexpr PlacementHints PLACEMENT_CPU_PATCHED_AT_LOAD = 1 << 3;
+// the CPU patches the buffer before inferences (JIT relocation targets): hot for the CPU
+constexpr PlacementHints PLACEMENT_CPU_PATCHED_PER_INFERENCE = 1 << 4;
+// the device never accesses the buffer (e.g. backups, relocation and symbol tables)
+constexpr PlacementHints PLACEMENT_CPU_ONLY = 1 << 5;
+
 struct BufferSpecs {
 public:
     uint64_t alignment;
     uint64_t size;
     Elf_Xword procFlags;
-    BufferSpecs(): alignment(0), size(0), procFlags(0) {
+    PlacementHints placementHints;
+    BufferSpecs(): alignment(0), size(0), procFlags(0), placementHints(PLACEMENT_NONE) {
     }
-    BufferSpecs(uint64_t alignment, uint64_t size, uint64_t procFlags)
-            : alignment(alignment), size(size), procFlags(procFlags) {
+    BufferSpecs(uint64_t alignment, uint64_t size, uint64_t procFlags,
+                PlacementHints placementHints = PLACEMENT_NONE)
+            : alignment(alignment), size(size), procFlags(procFlags), placementHints(placementHints) {
     }
     bool isSharable() const {
         return procFlags & SHARABLE_BUFFER_ENABLED;
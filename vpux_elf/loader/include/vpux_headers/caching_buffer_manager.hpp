@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <vpux_headers/buffer_manager.hpp>
+#include <vpux_headers/buffer_specs.hpp>
+#include <vpux_headers/device_buffer.hpp>
+
+namespace elf {
+
+/**
+ * BufferManager decorator recycling the deallocated DeviceBuffers.
+ *
+ * Deallocated buffers are kept in free lists keyed by {size class, alignment, procFlags, placementHints} and handed
+ * out again by the next allocate call of the same key, so that steady-state clone churn never reaches the underlying
+ * allocator. Sizes are rounded up to size classes (4 per power of two, at least MIN_SIZE_CLASS), so a recycled buffer
+ * wastes at most 25% of its allocation. The returned DeviceBuffers keep the requested size; lock, unlock and copy
+ * calls are forwarded to the underlying manager with the full allocation.
+ *
+ * The cached bytes are capped: when a deallocation would exceed the cap, the least recently deallocated buffers are
+ * released to the underlying manager first. Recycled buffers are not cleared.
+ *
+ * Buffers are tracked by vpu_addr, which must therefore be unique among the live buffers of the underlying manager.
+ * Sharable buffers (SHARABLE_BUFFER_ENABLED) and empty allocations (vpu_addr 0) are not cached nor tracked: they are
+ * passed through to the underlying manager, as are the calls with buffers the decorator didn't allocate, such as the
+ * shared scratch buffers handed to updateSharedScratchBuffers.
+ * All the buffers allocated through the decorator must be deallocated before it is destroyed.
+ */
+class CachingBufferManager final : public BufferManager {
+public:
+    static constexpr size_t MIN_SIZE_CLASS = 4096;
+    static constexpr size_t DEFAULT_MAX_CACHED_SIZE = size_t{256} * 1024 * 1024;
+
+    struct CacheStats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t trimmedBuffers = 0;
+        size_t cachedBuffers = 0;
+        size_t cachedSize = 0;
+    };
+
+    explicit CachingBufferManager(BufferManager* bufferManager, size_t maxCachedSize = DEFAULT_MAX_CACHED_SIZE);
+    CachingBufferManager(const CachingBufferManager&) = delete;
+    CachingBufferManager& operator=(const CachingBufferManager&) = delete;
+    ~CachingBufferManager() override;
+
+    DeviceBuffer allocate(const BufferSpecs& buffSpecs) override;
+    void deallocate(DeviceBuffer& devAddress) override;
+    void lock(DeviceBuffer& devAddress) override;
+    void unlock(DeviceBuffer& devAddress) override;
+    void lockMany(const std::vector<DeviceBuffer*>& devAddresses) override;
+    void unlockMany(const std::vector<DeviceBuffer*>& devAddresses) override;
+    size_t copy(DeviceBuffer& to, const uint8_t* from, size_t count) override;
+    size_t copyv(const std::vector<BufferCopy>& copies) override;
+    size_t copyAt(DeviceBuffer& to, size_t offset, const uint8_t* from, size_t count) override;
+
+    // Releases the least recently deallocated buffers until at most maxCachedSize bytes remain cached
+    void trim(size_t maxCachedSize = 0);
+    // Changes the cap, trimming the cache if needed
+    void setMaxCachedSize(size_t maxCachedSize);
+    size_t getMaxCachedSize() const;
+    CacheStats getCacheStats() const;
+
+    static size_t getSizeClass(size_t size);
+
+private:
+    using FreeListKey =
+            std::tuple<size_t /*size class*/, uint64_t /*alignment*/, Elf_Xword /*procFlags*/, PlacementHints>;
+
+    struct CachedBuffer {
+        FreeListKey key;
+        DeviceBuffer buffer;
+    };
+    using CachedBuffers = std::list<CachedBuffer>;
+
+    // Copies the full allocation backing a DeviceBuffer handed out by allocate, returns false for untracked buffers
+    bool findAllocation(const DeviceBuffer& devAddress, DeviceBuffer& allocation) const;
+    // Stores the allocation updated by a lock or unlock call of the underlying manager, if it is still live
+    void updateAllocation(const DeviceBuffer& allocation);
+    void trimLocked(size_t maxCachedSize);
+
+    BufferManager* mBufferManager;
+    size_t mMaxCachedSize;
+
+    mutable std::mutex mMutex;
+    // cached buffers in deallocation order, the front one is trimmed first
+    CachedBuffers mCachedBuffers;
+    // per key, the cached buffers of mCachedBuffers in deallocation order
+    std::map<FreeListKey, std::deque<CachedBuffers::iterator>> mFreeLists;
+    // allocations backing the live buffers, keyed by vpu_addr
+    std::unordered_map<uint64_t, CachedBuffer> mLiveBuffers;
+    CacheStats mStats;
+};
+
+}  // namespace elf
@@ -5,7 +5,9 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <cstddef>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 #include <vpux_elf/utils/log.hpp>
@@ -27,7 +29,61 @@ public:
         BufferDetails mBufferDetails = {};
     };
 
-    using BufferMap = std::unordered_map<size_t, BufferInfo>;
+    // Section indexes are small and dense, so the buffers are stored in a vector indexed by section index
+    // Slots without a BufferInfo are marked by the presence bits and skipped when iterating
+    using BufferSlot = std::pair<size_t /*section index*/, BufferInfo>;
+    using BufferSlots = std::vector<BufferSlot>;
+
+    // Iterates over the present slots in section index order
+    template <typename Container, typename Slot>
+    class SlotIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = BufferSlot;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Slot*;
+        using reference = Slot&;
+
+        SlotIterator(Container* container, size_t index): mContainer(container), mIndex(index) {
+            skipAbsent();
+        }
+
+        reference operator*() const {
+            return mContainer->mBufferSlots[mIndex];
+        }
+        pointer operator->() const {
+            return &mContainer->mBufferSlots[mIndex];
+        }
+        SlotIterator& operator++() {
+            ++mIndex;
+            skipAbsent();
+            return *this;
+        }
+        SlotIterator operator++(int) {
+            auto it = *this;
+            ++(*this);
+            return it;
+        }
+        bool operator==(const SlotIterator& other) const {
+            return mIndex == other.mIndex;
+        }
+        bool operator!=(const SlotIterator& other) const {
+            return mIndex != other.mIndex;
+        }
+
+    private:
+        void skipAbsent() {
+            while (mIndex < mContainer->mPresent.size() && !mContainer->mPresent[mIndex]) {
+                ++mIndex;
+            }
+        }
+
+        Container* mContainer;
+        size_t mIndex;
+    };
+
+    using iterator = SlotIterator<DeviceBufferContainer, BufferSlot>;
+    using const_iterator = SlotIterator<const DeviceBufferContainer, const BufferSlot>;
 
     DeviceBufferContainer(BufferManager* bManager);
     DeviceBufferContainer(const DeviceBufferContainer& other);
@@ -36,31 +92,39 @@ public:
     DeviceBufferContainer& operator=(const DeviceBufferContainer& rhs);
     DeviceBufferContainer& operator=(DeviceBufferContainer&&) = default;
 
-    auto cbegin() const {
-        return mBufferMap.cbegin();
+    const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator cend() const {
+        return const_iterator(this, mBufferSlots.size());
+    }
+    const_iterator begin() const {
+        return cbegin();
     }
-    auto cend() const {
-        return mBufferMap.cend();
+    const_iterator end() const {
+        return cend();
     }
-    auto begin() {
-        return mBufferMap.begin();
+    iterator begin() {
+        return iterator(this, 0);
     }
-    auto end() {
-        return mBufferMap.end();
+    iterator end() {
+        return iterator(this, mBufferSlots.size());
     }
 
     BufferPtr buildAllocatedDeviceBuffer(BufferSpecs bSpecs);
     BufferInfo& safeInitBufferInfoAtIndex(size_t index);
     BufferInfo& getBufferInfoFromIndex(size_t index);
-    bool hasBufferInfoAtIndex(size_t index);
-    size_t getBufferInfoCount();
+    bool hasBufferInfoAtIndex(size_t index) const;
+    size_t getBufferInfoCount() const;
     std::vector<DeviceBuffer> getBuffersAsVector() const;
 
 private:
-    BufferMap mBufferMap;
+    BufferSlots mBufferSlots;
+    std::vector<bool> mPresent;
+    size_t mBufferInfoCount = 0;
     BufferManager* mBufferManager;
 
-    void copyBufferMap(const BufferMap& otherBufferMap);
+    void copyBufferSlots(const DeviceBufferContainer& other);
 };
 
 }  // namespace elf
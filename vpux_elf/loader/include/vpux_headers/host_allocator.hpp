@@ -0,0 +1,170 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace elf {
+
+// Policy which served a host allocation
+enum class HostAllocationPolicy {
+    ALIGNED_NEW,
+    HUGE_PAGES,
+    USER_CALLBACK,
+    MONOTONIC_ARENA,
+    NUMA_NODE,
+};
+
+const char* stringifyHostAllocationPolicy(HostAllocationPolicy policy);
+
+struct HostAllocation {
+    void* ptr = nullptr;
+    // bytes actually reserved, at least the requested size
+    size_t size = 0;
+    size_t alignment = 0;
+    HostAllocationPolicy policy = HostAllocationPolicy::ALIGNED_NEW;
+};
+
+/**
+ * Allocation policy of the host memory of the DynamicBuffers. Allocators are shared by the factories and buffers
+ * using them, and must support concurrent calls.
+ */
+class HostAllocator {
+public:
+    virtual ~HostAllocator() = default;
+
+    // alignment is a power of two
+    virtual HostAllocation allocate(size_t size, size_t alignment) = 0;
+    virtual void deallocate(const HostAllocation& allocation) = 0;
+
+    // AlignedHostAllocator instance used when no allocator is given
+    static const std::shared_ptr<HostAllocator>& getDefault();
+};
+
+// Aligned operator new
+class AlignedHostAllocator final : public HostAllocator {
+public:
+    HostAllocation allocate(size_t size, size_t alignment) override;
+    void deallocate(const HostAllocation& allocation) override;
+};
+
+/**
+ * Allocations of at least minHugePageSize bytes are memory-mapped on huge page boundaries and advised to use
+ * transparent huge pages (MADV_HUGEPAGE), which cuts the TLB misses of the CPU-side relocations on large sections.
+ * Smaller allocations, larger alignments, platforms without mmap and failed mappings fall back to aligned operator new.
+ */
+class HugePageHostAllocator final : public HostAllocator {
+public:
+    static constexpr size_t HUGE_PAGE_SIZE = size_t{2} * 1024 * 1024;
+
+    explicit HugePageHostAllocator(size_t minHugePageSize = HUGE_PAGE_SIZE);
+
+    HostAllocation allocate(size_t size, size_t alignment) override;
+    void deallocate(const HostAllocation& allocation) override;
+
+private:
+    size_t mMinHugePageSize;
+    AlignedHostAllocator mFallback;
+};
+
+/**
+ * Allocations are memory-mapped and their pages prefer the given NUMA node, e.g. the node closest to the NPU.
+ * Allocations below minNumaSize, alignments above the page size, unavailable nodes (including NO_NUMA_NODE) and
+ * platforms without NUMA support fall back to aligned operator new.
+ */
+class NumaHostAllocator final : public HostAllocator {
+public:
+    static constexpr size_t PAGE_SIZE = 4096;
+
+    explicit NumaHostAllocator(int numaNode, size_t minNumaSize = PAGE_SIZE);
+
+    HostAllocation allocate(size_t size, size_t alignment) override;
+    void deallocate(const HostAllocation& allocation) override;
+
+    int getNumaNode() const;
+
+private:
+    int mNumaNode;
+    size_t mMinNumaSize;
+    bool mNodeAvailable;
+    AlignedHostAllocator mFallback;
+};
+
+// User provided allocation functions, allocate must return memory aligned to alignment or nullptr on failure
+class CallbackHostAllocator final : public HostAllocator {
+public:
+    using AllocateCallback = std::function<void*(size_t size, size_t alignment)>;
+    using DeallocateCallback = std::function<void(void* ptr, size_t size)>;
+
+    CallbackHostAllocator(AllocateCallback allocateCallback, DeallocateCallback deallocateCallback);
+
+    HostAllocation allocate(size_t size, size_t alignment) override;
+    void deallocate(const HostAllocation& allocation) override;
+
+private:
+    AllocateCallback mAllocateCallback;
+    DeallocateCallback mDeallocateCallback;
+};
+
+/**
+ * Monotonic arena: allocations are carved out of large blocks and never reused individually. The blocks are freed
+ * together once every allocation has been deallocated (the carved block is kept and rewound for the next load), or
+ * when the arena is destroyed. Meant to be owned by a single loader, see HostArenaBufferFactory, so that its many
+ * short-lived Reader buffers (relocations, symbol tables, notes, backups) cost a pointer bump instead of a heap
+ * allocation each.
+ *
+ * Allocations larger than the block size get a dedicated block. Calls are serialized by a mutex, which is only
+ * contended by the threads of a single loader.
+ */
+class MonotonicHostAllocator final : public HostAllocator {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = size_t{4} * 1024 * 1024;
+    static constexpr size_t BLOCK_ALIGNMENT = 4096;
+
+    struct ArenaStats {
+        size_t blocks = 0;
+        size_t reservedSize = 0;
+        size_t usedSize = 0;
+        size_t liveAllocations = 0;
+    };
+
+    // the blocks are allocated through blockAllocator, e.g. a NumaHostAllocator
+    explicit MonotonicHostAllocator(size_t blockSize = DEFAULT_BLOCK_SIZE,
+                                    std::shared_ptr<HostAllocator> blockAllocator = HostAllocator::getDefault());
+    MonotonicHostAllocator(const MonotonicHostAllocator&) = delete;
+    MonotonicHostAllocator& operator=(const MonotonicHostAllocator&) = delete;
+    ~MonotonicHostAllocator() override;
+
+    HostAllocation allocate(size_t size, size_t alignment) override;
+    void deallocate(const HostAllocation& allocation) override;
+
+    ArenaStats getArenaStats() const;
+
+private:
+    struct Block {
+        HostAllocation allocation;
+        size_t offset;
+        // holds a single allocation larger than the block size
+        bool dedicated;
+    };
+
+    // Frees every block but the carved one and rewinds it
+    void releaseLocked();
+
+    size_t mBlockSize;
+    std::shared_ptr<HostAllocator> mBlockAllocator;
+
+    mutable std::mutex mMutex;
+    // the last block is the one being carved
+    std::vector<Block> mBlocks;
+    ArenaStats mStats;
+};
+
+}  // namespace elf
@@ -5,12 +5,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
 #include <vpux_headers/buffer_manager.hpp>
 #include <vpux_headers/buffer_specs.hpp>
 #include <vpux_headers/device_buffer.hpp>
+#include <vpux_headers/host_allocator.hpp>
 
 namespace elf {
 
@@ -34,11 +36,44 @@ public:
     virtual void unlock();
     virtual void load(const uint8_t* from, size_t count);
     virtual void loadWithLock(const uint8_t* from, size_t count);
+    // Loads count bytes at offset inside the buffer, which must be locked by the caller
+    virtual void loadAt(size_t offset, const uint8_t* from, size_t count);
+    // Bytes of memory held by the buffer, used for the memory accounting
+    virtual size_t getOwnedSize() const;
+
+    // Locks are counted, so nested lock calls are allowed. Only the first lock and the last unlock need a
+    // BufferManager call, in which case acquireLock/releaseLock return the manager and the DeviceBuffer to pass to it
+    struct LockRequest {
+        BufferManager* manager = nullptr;
+        DeviceBuffer* buffer = nullptr;
+    };
+    virtual LockRequest acquireLock();
+    virtual LockRequest releaseLock();
+
+    // Buffers uploaded through BufferManager::copy return the manager, the DeviceBuffer to copy to and the offset of
+    // the buffer inside it (arena views), the others (host memory) are loaded with a plain memcpy
+    struct CopyTarget {
+        BufferManager* manager = nullptr;
+        DeviceBuffer* buffer = nullptr;
+        size_t offset = 0;
+    };
+    virtual CopyTarget getCopyTarget();
+
+    struct LoadRequest {
+        ManagedBuffer* buffer = nullptr;
+        const uint8_t* from = nullptr;
+        size_t count = 0;
+    };
+    // Same as a load call for every request, with a single BufferManager::copyv call per BufferManager
+    // The buffers must be locked by the caller
+    static void loadMany(const std::vector<LoadRequest>& loads);
 
 protected:
     DeviceBuffer mDevBuffer;
     BufferSpecs mBufferSpecs;
     void* mUserPrivateData;
+    // buffers shared by loader copies and by the shared section registry can be locked from several threads
+    std::atomic<size_t> mLockCount{0};
 };
 
 class AllocatedDeviceBuffer final : public ManagedBuffer {
@@ -47,26 +82,46 @@ public:
 
     ~AllocatedDeviceBuffer();
 
+    // Deallocates the current allocation and takes ownership of newBuffer, which must have been allocated through the
+    // same BufferManager: it is deallocated through it when the AllocatedDeviceBuffer is destroyed
+    void replaceAllocation(const DeviceBuffer& newBuffer);
+
     std::unique_ptr<ManagedBuffer> createNew() const override;
-    void lock() override;
-    void unlock() override;
     void load(const uint8_t* from, size_t count) override;
+    void loadAt(size_t offset, const uint8_t* from, size_t count) override;
+    LockRequest acquireLock() override;
+    LockRequest releaseLock() override;
+    CopyTarget getCopyTarget() override;
 
 private:
     BufferManager* mBufferManager;
 };
 
+/**
+ * Host memory buffer, allocated through a HostAllocator (aligned operator new by default).
+ * Buffers created by createNew use the same allocator.
+ */
 class DynamicBuffer final : public ManagedBuffer {
 public:
-    explicit DynamicBuffer(BufferSpecs bSpecs);
+    explicit DynamicBuffer(BufferSpecs bSpecs,
+                           std::shared_ptr<HostAllocator> hostAllocator = HostAllocator::getDefault());
+    DynamicBuffer(const DynamicBuffer& other) = delete;
+    DynamicBuffer& operator=(const DynamicBuffer& rhs) = delete;
+
+    ~DynamicBuffer();
 
-    ~DynamicBuffer() = default;
+    // Bytes requested from the HostAllocator for a buffer of size bytes
+    static size_t getAllocationSize(size_t size);
 
     std::unique_ptr<ManagedBuffer> createNew() const override;
+    size_t getOwnedSize() const override;
+    // policy which served the allocation, may differ from the allocator's preferred one after a fallback
+    HostAllocationPolicy getHostAllocationPolicy() const;
 
 private:
     static constexpr size_t mDefaultSafeAlignment = 64;
-    std::vector<uint8_t> mData;
+    std::shared_ptr<HostAllocator> mHostAllocator;
+    HostAllocation mAllocation;
 };
 
 class StaticBuffer final : public ManagedBuffer {
@@ -78,6 +133,64 @@ public:
     ~StaticBuffer() = default;
 
     std::unique_ptr<ManagedBuffer> createNew() const override;
+    // the memory is owned by the user
+    size_t getOwnedSize() const override;
+};
+
+/**
+ * Single device allocation shared by the ArenaBufferView objects sub-allocated from it.
+ * The views share the lock counter of the arena: it is locked by the first view lock and unlocked by the last view
+ * unlock.
+ *
+ * Arenas are uploaded like any AllocatedDeviceBuffer. Copies from host memory made by the loader (section data,
+ * backups) go through the BufferManager (copyAt, copyv), never through a memcpy to cpu_addr. Data read from the blob
+ * by the AccessManager (readExternal, e.g. backup-free reloads and shared segments) is written by the AccessManager
+ * into the locked arena, as it is for the buffers of every other section.
+ */
+class DeviceBufferArena final {
+public:
+    DeviceBufferArena(BufferManager* bManager, BufferSpecs bSpecs);
+    DeviceBufferArena(const DeviceBufferArena& other) = delete;
+    DeviceBufferArena& operator=(const DeviceBufferArena& rhs) = delete;
+
+    ~DeviceBufferArena() = default;
+
+    std::shared_ptr<DeviceBufferArena> createNew() const;
+    // New arena allocated with the same BufferManager, but different specs
+    std::shared_ptr<DeviceBufferArena> createNew(BufferSpecs bSpecs) const;
+    DeviceBuffer getBuffer() const;
+    ManagedBuffer::LockRequest acquireLock();
+    ManagedBuffer::LockRequest releaseLock();
+    ManagedBuffer::CopyTarget getCopyTarget();
+    void load(uint64_t offset, const uint8_t* from, size_t count);
+
+private:
+    BufferManager* mBufferManager;
+    AllocatedDeviceBuffer mBuffer;
+};
+
+class ArenaBufferView final : public ManagedBuffer {
+public:
+    ArenaBufferView(std::shared_ptr<DeviceBufferArena> arena, uint64_t offset, BufferSpecs bSpecs);
+
+    ~ArenaBufferView() = default;
+
+    // The new view is the only one of a newly allocated arena
+    std::unique_ptr<ManagedBuffer> createNew() const override;
+    // The new view has the same offset inside the given arena, which should be a createNew() copy of this one's arena
+    std::unique_ptr<ArenaBufferView> createNewInArena(std::shared_ptr<DeviceBufferArena> arena) const;
+    const std::shared_ptr<DeviceBufferArena>& getArena() const;
+    // the view follows the arena, whose cpu_addr may change every time it is locked
+    DeviceBuffer getBuffer() const override;
+    void load(const uint8_t* from, size_t count) override;
+    void loadAt(size_t offset, const uint8_t* from, size_t count) override;
+    LockRequest acquireLock() override;
+    LockRequest releaseLock() override;
+    CopyTarget getCopyTarget() override;
+
+private:
+    std::shared_ptr<DeviceBufferArena> mArena;
+    uint64_t mOffset;
 };
 
 /**
@@ -102,4 +215,20 @@ private:
     ManagedBuffer* mDevBuffer = nullptr;
 };
 
+/**
+ * Lock guard for a set of buffers. The buffers not locked yet are locked with a single BufferManager::lockMany call
+ * (per BufferManager) and unlocked with a single unlockMany call. Lock guards of buffers of the set nested inside its
+ * scope don't reach the BufferManager anymore.
+ */
+class ElfBufferBatchLockGuard {
+public:
+    explicit ElfBufferBatchLockGuard(const std::vector<ManagedBuffer*>& devBuffers);
+    ElfBufferBatchLockGuard(const ElfBufferBatchLockGuard&) = delete;
+    ElfBufferBatchLockGuard& operator=(const ElfBufferBatchLockGuard&) = delete;
+    ~ElfBufferBatchLockGuard();
+
+private:
+    std::vector<ManagedBuffer*> mDevBuffers;
+};
+
 }  // namespace elf
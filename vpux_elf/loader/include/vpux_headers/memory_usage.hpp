@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <map>
+
+#include <vpux_elf/types/data_types.hpp>
+
+namespace elf {
+
+/**
+ * Memory held by a loader (or a HostParsedInference), broken down by category.
+ * The shared categories are held once by a loader and all of its copies.
+ */
+struct MemoryUsage {
+    // device buffers owned by a single loader: writable sections and scratch buffers
+    size_t deviceBytes = 0;
+    // read-only device sections, shared by a loader and its copies
+    size_t sharedDeviceBytes = 0;
+    // CPU copies of the writable sections used to restore them, shared by a loader and its copies
+    size_t backupBytes = 0;
+    // section contents cached by the Reader (symbol tables, relocations, notes), shared by a loader and its copies
+    size_t sectionDataBytes = 0;
+    // deviceBytes + sharedDeviceBytes per processor flags of the sections (SHF_EXECINSTR, VPU_SHF_PROC_*)
+    std::map<Elf_Xword, size_t> deviceBytesByProcFlags;
+
+    size_t getDeviceBytes() const {
+        return deviceBytes + sharedDeviceBytes;
+    }
+
+    size_t getHostBytes() const {
+        return backupBytes + sectionDataBytes;
+    }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) {
+        deviceBytes += other.deviceBytes;
+        sharedDeviceBytes += other.sharedDeviceBytes;
+        backupBytes += other.backupBytes;
+        sectionDataBytes += other.sectionDataBytes;
+        for (const auto& procFlagsBytes : other.deviceBytesByProcFlags) {
+            deviceBytesByProcFlags[procFlagsBytes.first] += procFlagsBytes.second;
+        }
+        return *this;
+    }
+
+    // Element-wise maximum, used to track the high-water marks
+    void updatePeak(const MemoryUsage& current) {
+        deviceBytes = std::max(deviceBytes, current.deviceBytes);
+        sharedDeviceBytes = std::max(sharedDeviceBytes, current.sharedDeviceBytes);
+        backupBytes = std::max(backupBytes, current.backupBytes);
+        sectionDataBytes = std::max(sectionDataBytes, current.sectionDataBytes);
+        for (const auto& procFlagsBytes : current.deviceBytesByProcFlags) {
+            auto& peakBytes = deviceBytesByProcFlags[procFlagsBytes.first];
+            peakBytes = std::max(peakBytes, procFlagsBytes.second);
+        }
+    }
+};
+
+/**
+ * Upper bounds of the memory allocated by a load or a copy, checked before anything is allocated
+ */
+struct MemoryBudget {
+    size_t deviceBytes = std::numeric_limits<size_t>::max();
+    size_t hostBytes = std::numeric_limits<size_t>::max();
+
+    // Throws an AllocError naming the operation if the usage exceeds the budget
+    void check(const MemoryUsage& usage, const char* operation) const;
+};
+
+}  // namespace elf
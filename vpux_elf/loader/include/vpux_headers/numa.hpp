@@ -0,0 +1,48 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace elf {
+
+namespace numa {
+
+// Hint value meaning that no NUMA placement is requested
+constexpr int NO_NUMA_NODE = -1;
+
+// Whether the node exists on this machine, always false on platforms without NUMA support
+bool isNodeAvailable(int node);
+
+// CPUs of the node, empty if the node is not available
+std::vector<size_t> getNodeCPUs(int node);
+
+// Sets the preferred node of the pages of a page aligned range, returns false if the policy could not be set
+bool bindMemoryToNode(void* addr, size_t size, int node);
+
+}  // namespace numa
+
+/**
+ * Pins the calling thread to the CPUs of a NUMA node for the lifetime of the object, then restores its previous
+ * affinity. NO_NUMA_NODE, unavailable nodes and platforms without NUMA support leave the affinity untouched.
+ */
+class ScopedNumaAffinity final {
+public:
+    explicit ScopedNumaAffinity(int node);
+    ScopedNumaAffinity(const ScopedNumaAffinity&) = delete;
+    ScopedNumaAffinity& operator=(const ScopedNumaAffinity&) = delete;
+    ~ScopedNumaAffinity();
+
+    bool isPinned() const;
+
+private:
+    bool mPinned = false;
+    // CPUs of the previous affinity
+    std::vector<size_t> mPreviousCPUs;
+};
+
+}  // namespace elf
@@ -0,0 +1,44 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vpux_elf/utils/sha256.hpp>
+
+namespace elf {
+
+/**
+ * On-disk cache of the state a loader derives from a blob before load (compiled relocation plan, IO descriptors), so
+ * that a process restart does not decode and validate the blob again.
+ *
+ * Entries are keyed by a digest identifying the blob the state is derived from, combined with the context string
+ * (arch and library version), and stored as one file per entry in the cache directory. Each file records its full
+ * key and a checksum of its contents, so stale, truncated or corrupted files are ignored. Write failures are only
+ * logged: the cache is an optimization, never a requirement.
+ */
+class PrelinkCache final {
+public:
+    PrelinkCache(std::string directory, std::string context);
+
+    // Returns the state stored for key, or an empty vector if there is no valid entry
+    std::vector<uint8_t> read(const utils::Sha256Digest& key) const;
+    void write(const utils::Sha256Digest& key, const std::vector<uint8_t>& state) const;
+
+    const std::string& getDirectory() const;
+    const std::string& getContext() const;
+
+private:
+    utils::Sha256Digest getEntryKey(const utils::Sha256Digest& key) const;
+    std::string getEntryPath(const utils::Sha256Digest& entryKey) const;
+
+    std::string mDirectory;
+    std::string mContext;
+};
+
+}  // namespace elf
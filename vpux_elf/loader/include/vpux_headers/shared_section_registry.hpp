@@ -0,0 +1,72 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+#include <vpux_elf/types/data_types.hpp>
+#include <vpux_elf/utils/sha256.hpp>
+#include <vpux_headers/buffer_manager.hpp>
+#include <vpux_headers/managed_buffer.hpp>
+
+namespace elf {
+
+/**
+ * Process-wide content-addressed registry of the shared (read-only, not relocated) section buffers.
+ *
+ * Buffers are keyed by the SHA-256 digest of the section bytes, the section size, alignment and flags, and the
+ * BufferManager owning them, so that model variants with byte-identical weights or kernels map to a single device
+ * buffer. The registry only holds weak references: the loaders (and their copies) using a buffer keep it alive, and it
+ * is deallocated with the last of them. Buffers not owning their memory, i.e. emplaced in a blob, are never registered.
+ */
+class SharedSectionRegistry final {
+public:
+    struct Key {
+        utils::Sha256Digest digest;
+        Elf_Xword size;
+        Elf_Xword alignment;
+        Elf_Xword flags;
+        const BufferManager* bufferManager;
+
+        bool operator<(const Key& other) const {
+            return std::tie(digest, size, alignment, flags, bufferManager) <
+                   std::tie(other.digest, other.size, other.alignment, other.flags, other.bufferManager);
+        }
+    };
+
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t liveBuffers = 0;
+        size_t liveSize = 0;
+    };
+
+    static SharedSectionRegistry& getInstance();
+
+    /**
+     * Returns the live buffer registered for key, or the one built by createBuffer, which is then registered.
+     * createBuffer runs outside of the registry lock, if another thread registers the same key meanwhile its buffer
+     * is returned instead.
+     */
+    std::shared_ptr<ManagedBuffer> getOrCreate(const Key& key,
+                                               const std::function<std::shared_ptr<ManagedBuffer>()>& createBuffer);
+
+    Stats getStats() const;
+
+private:
+    SharedSectionRegistry() = default;
+    std::shared_ptr<ManagedBuffer> findLocked(const Key& key);
+
+    mutable std::mutex mMutex;
+    std::map<Key, std::weak_ptr<ManagedBuffer>> mBuffers;
+    Stats mStats;
+};
+
+}  // namespace elf
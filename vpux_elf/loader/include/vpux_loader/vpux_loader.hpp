@@ -14,6 +14,8 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
+#include <utility>
 #include <vector>
 
 #include <vpux_elf/accessor.hpp>
@@ -24,6 +26,9 @@
 #include <vpux_headers/device_buffer.hpp>
 #include <vpux_headers/device_buffer_container.hpp>
 #include <vpux_headers/managed_buffer.hpp>
+#include <vpux_headers/memory_usage.hpp>
+#include <vpux_headers/numa.hpp>
+#include <vpux_headers/prelink_cache.hpp>
 
 #include <vpux_elf/types/elf_structs.hpp>
 #include <vpux_elf/types/relocation_entry.hpp>
@@ -31,6 +36,7 @@
 #include <vpux_elf/types/vpu_extensions.hpp>
 #include <vpux_elf/utils/error.hpp>
 #include <vpux_headers/metadata.hpp>
+#include <vpux_headers/platform.hpp>
 #include <vpux_headers/serial_metadata.hpp>
 
 namespace elf {
@@ -55,7 +61,19 @@ private:
     static const std::map<RelocationType, RelocationFunc> relocationMap;
 
 public:
-    VPUXLoader(AccessManager* accessor, BufferManager* bufferManager);
+    /**
+     * With a prelinkCache, the state derived from the blob at construction (relocation plan, IO descriptors) is read
+     * from the cache if a valid entry exists, and stored into it otherwise, unless the state is not smaller than the
+     * relocation sections it replaces. The cache is only used by the constructor.
+     * The entries are keyed by blobDigest, a digest of the whole blob supplied by the caller (e.g. computed once when
+     * the blob was compiled or downloaded), combined with the ELF and section headers. A warm construction therefore
+     * reads neither the relocation nor the IO sections. blobDigest is required with a prelinkCache.
+     */
+    VPUXLoader(AccessManager* accessor, BufferManager* bufferManager, const PrelinkCache* prelinkCache = nullptr,
+               const utils::Sha256Digest& blobDigest = {});
+    // The loader and its copies share the ownership of the AccessManager
+    VPUXLoader(std::shared_ptr<AccessManager> accessor, BufferManager* bufferManager,
+               const PrelinkCache* prelinkCache = nullptr, const utils::Sha256Digest& blobDigest = {});
     VPUXLoader(const VPUXLoader& other);
     VPUXLoader(const VPUXLoader& other, const std::vector<SymbolEntry>& runtimeSymTabs);
     VPUXLoader(VPUXLoader&& other) = delete;
@@ -77,24 +95,250 @@ public:
     std::vector<std::shared_ptr<ManagedBuffer>> getSectionsOfType(elf::Elf_Word type);
     void setInferencesMayBeRunInParallel(bool inferencesMayBeRunInParallel);
     bool getInferencesMayBeRunInParallel() const;
+
+    /**
+     * Arena mode: instead of one allocation per section, the loader owned sections are grouped by their flags and each
+     * group is sub-allocated from a single allocation (respecting sh_addralign). Sharable scratch sections are still
+     * allocated on their own. Must be set before load(), copies of the loader inherit it.
+     */
+    void setArenaAllocations(bool arenaAllocations);
+    bool getArenaAllocations() const;
+
+    /**
+     * Segment mode: the sections of each PT_LOAD segment of the blob (see Writer::setLoadSegments) are views into one
+     * allocation of the segment size, at their sh_addr offset inside the segment. The read-only segments are uploaded
+     * with a single read of their bytes, instead of going through the shared section buffers (so deduplication and
+     * streaming don't apply to them), the writable ones are loaded per section like the other loader owned sections.
+     * Sections out of the segments, or in a segment mixing shared and loader owned sections, fall back to the arena
+     * mode if enabled, or to one allocation per section. Must be set before load(), copies of the loader inherit it.
+     */
+    void setSegmentAllocations(bool segmentAllocations);
+    bool getSegmentAllocations() const;
+
+    /**
+     * Backup-free reload mode: no CPU copy of the writable sections is kept after load(). Copies of the loader,
+     * reloadNewBuffers and moveBuffers read the pristine section bytes again from the AccessManager, which for DDR
+     * sources is a single copy from the blob to the device buffer.
+     * In this mode the AccessManager must outlive the loader and all of its copies, so either keep it alive or use the
+     * constructor taking ownership of it. Must be set before load(), copies of the loader inherit it.
+     */
+    void setBackupFreeReload(bool backupFreeReload);
+    bool getBackupFreeReload() const;
+
+    /**
+     * Profiling elision: for blobs compiled with profiling, run without profiling buffers.
+     * Profiling-only sections (allocatable sections flagged VPU_SHF_PROFOUTPUT) are neither allocated nor loaded and
+     * the relocations targeting them are skipped. The profiling pointers, i.e. the VPU_SHF_PROFOUTPUT JIT relocations
+     * and the relocations against symbols of profiling-only sections, are patched once at load as if every profiling
+     * buffer was located at profilingDummyAddress. applyJitRelocations then ignores the profiling buffers and
+     * getProfBuffers returns none. Must be set before load(), copies of the loader inherit it.
+     */
+    void setProfilingElision(bool profilingElision, uint64_t profilingDummyAddress = 0);
+    bool getProfilingElision() const;
+
+    /**
+     * Pipelined load: load() reads the section backups, allocates the device buffers and uploads the sections
+     * concurrently, on a reader thread, an allocator thread and the calling thread. Each stage runs at most
+     * maxSectionsInFlight sections ahead of the upload, and the relocations of a section are applied as soon as it is
+     * uploaded and every section has an address.
+     * The BufferManager must support concurrent calls from different threads, the AccessManager is used by a single
+     * thread at a time. Must be set before load(), copies of the loader are not affected.
+     */
+    void setPipelinedLoad(bool pipelinedLoad, size_t maxSectionsInFlight = DEFAULT_MAX_SECTIONS_IN_FLIGHT);
+    bool getPipelinedLoad() const;
+    static constexpr size_t DEFAULT_MAX_SECTIONS_IN_FLIGHT = 8;
+
+    /**
+     * Shared section deduplication: the shared (read-only, not relocated) sections are looked up by content in the
+     * process-wide SharedSectionRegistry, and a section byte-identical to one already loaded by another loader maps to
+     * the same device buffer instead of being allocated and uploaded again. Each shared section is hashed at load.
+     * Must be set before load(), copies of the loader share the buffers anyway.
+     */
+    void setSharedSectionDeduplication(bool sharedSectionDeduplication);
+    bool getSharedSectionDeduplication() const;
+
+    /**
+     * Streaming upload: the shared sections with NPU access larger than chunkSize are not read as a whole through the
+     * AccessManager. They are read in chunkSize pieces into two staging buffers on a reader thread, while the previous
+     * chunk is uploaded into the device buffer with BufferManager::copyAt, so that the host memory used is bounded by
+     * 2 * chunkSize. Meant for AccessManagers which copy the sections (e.g. FSAccessManager), emplacing ones don't
+     * need it. Must be set before load(), copies of the loader share the streamed buffers.
+     */
+    void setStreamingUpload(bool streamingUpload, size_t chunkSize = DEFAULT_STREAMING_CHUNK_SIZE);
+    bool getStreamingUpload() const;
+    static constexpr size_t DEFAULT_STREAMING_CHUNK_SIZE = size_t{8} * 1024 * 1024;
+
+    /**
+     * NUMA node hint, e.g. the node the NPU is attached to: load(), the copy constructors and the internal worker
+     * threads run pinned to the CPUs of the node, and the staging buffers of the streaming upload are allocated on it.
+     * The calling thread gets its affinity back afterwards. The Reader and backup buffers come from the BufferFactory
+     * of the AccessManager, pass it a NumaHostAllocator to place them on the node too. Unavailable nodes (e.g. on
+     * single-node machines) are ignored with a warning. Must be set before load(), copies of the loader inherit it.
+     */
+    void setNumaNode(int numaNode);
+    int getNumaNode() const;
+
+    /**
+     * Memory accounting: current memory held by the loader, and its high-water marks over load(), the copies and the
+     * assignments of the loader
+     */
+    // includeShared = false leaves out the categories shared with the copies of the loader
+    MemoryUsage getMemoryUsage(bool includeShared = true) const;
+    MemoryUsage getPeakMemoryUsage() const;
+    // Upper bound of the memory load() allocates, computed from the section headers only. The host bytes of the
+    // section data read by load() assume the default HostAllocator, which doesn't round the allocations up
+    MemoryUsage estimateLoadMemoryUsage(bool symTabOverrideMode = false) const;
+
+    /**
+     * Memory budget: load() and copies of the loader throw an AllocError before allocating anything if the memory
+     * they would allocate exceeds the budget. A copy only allocates the deviceBytes of the loader, the rest is shared.
+     * Copies of the loader inherit it.
+     */
+    void setMemoryBudget(const MemoryBudget& memoryBudget);
+    MemoryBudget getMemoryBudget() const;
     void updateSharedScratchBuffers(const std::vector<DeviceBuffer>& buffers);
+    // Specs of the scratch sections the BufferManager shared (returned empty allocations for), in the order expected by
+    // updateSharedScratchBuffers
+    std::vector<BufferSpecs> getSharedScratchBufferSpecs() const;
+
+    /**
+     * Move loader allocated buffers to new device locations
+     *
+     * @param moves pairs of {buffer returned by getAllocatedBuffers, new buffer of the same size already holding a copy
+     * of its contents}. The new buffers must have been allocated through the BufferManager of the loader, which takes
+     * ownership of them: the old buffers are deallocated by moveBuffers, the new ones when the loader is destroyed.
+     * The caller must not deallocate either of them.
+     *
+     * Linear patch sites (R_VPU_64, R_VPU_32, R_VPU_32_SUM, R_VPU_16_SUM) referencing a moved section only get the
+     * address delta added. Sections holding other patch sites referencing a moved section are restored and relocated
+     * again, including the JIT relocations if those were already applied. Sections with overlapping patch sites are
+     * always restored. Shared (read-only) buffers can't be moved.
+     */
+    void moveBuffers(const std::vector<std::pair<DeviceBuffer, DeviceBuffer>>& moves);
+
+    /**
+     * Ahead-of-time folding of the relocations against the runtime symbol table (VPU_RT_SYMTAB)
+     *
+     * Every such relocation section is applied to the bytes of its target section using the given runtime symbols
+     * and then dropped (turned into SHT_NULL). Sections whose patches overlap with the ones of other relocation
+     * sections are left untouched, as folding them would change the order in which the patches are applied.
+     * A SHT_NOTE section of type NT_NPU_RT_SYMTAB_FOLDED recording archKind and tileCount is appended.
+     *
+     * @return copy of the ELF blob with the folded relocations, or an unmodified copy if nothing could be folded
+     */
+    static std::vector<uint8_t> foldRuntimeSymTabRelocations(const uint8_t* elfBlob, size_t elfSize,
+                                                             const std::vector<SymbolEntry>& runtimeSymTabs,
+                                                             elf::platform::ArchKind archKind, uint8_t tileCount);
 
 private:
+    // Tag of the constructor copying the members of a loader, returned by checkCopyMemoryBudget: the copy constructors
+    // delegate to it, the budget check being evaluated before any member is initialized
+    struct CopyBudgetChecked {};
+    VPUXLoader(CopyBudgetChecked, const VPUXLoader& other, const std::vector<SymbolEntry>& runtimeSymTabs);
+
     bool checkSectionType(const elf::SectionHeader* section, Elf_Word secType) const;
     void earlyFetchIO(const elf::Reader<Elf64>::Section& section);
     void registerUserIO(std::vector<DeviceBuffer>& userIO, const elf::SymbolEntry* symbols, size_t symbolCount) const;
 
+    // Patch sites referencing the symbols of a section, used to rebase the section when it is moved
+    struct RebaseSites {
+        std::map<size_t /*target section index*/, std::vector<std::pair<Elf64_Addr /*offset*/, size_t /*size*/>>>
+                linearSites;
+        std::set<size_t /*target section index*/> nonLinearTargets;
+    };
+
+    // Relocations decoded and validated once at construction. The relocation types, symbol indexes, patch bounds and
+    // section cross-references of the plan are guaranteed to be valid, so applying it needs no per-relocation checks
+    struct RelocationRun {
+        const RelocationFunc* relocFunc;
+        Elf64_Addr offset;
+        Elf_Sxword addend;
+        Elf_Sxword addendStride;
+        Elf_Word type;
+        Elf_Word symIdx;
+        Elf_Word count;
+        Elf_Word stride;
+        Elf_Word patchSize;
+    };
+
+    struct RelocationSectionPlan {
+        Elf_Word symTabIdx;
+        Elf_Word targetSectionIdx;
+        Elf_Xword flags;
+        // highest referenced symbol index + 1
+        size_t symbolsCount;
+        std::vector<RelocationRun> runs;
+    };
+
+    struct RelocationPlan {
+        std::map<size_t /*relocation section index*/, RelocationSectionPlan> sections;
+        // minimum size of the runtime symbol table required by the VPU_RT_SYMTAB relocations
+        size_t runtimeSymbolsCount = 0;
+    };
+
+    void compileRelocationPlan(const std::vector<std::size_t>& relocationSectionIndexes);
+    utils::Sha256Digest getPrelinkKey(const utils::Sha256Digest& blobDigest) const;
+    std::vector<uint8_t> exportPrelinkState() const;
+    // Returns false, leaving the loader untouched, if the state is missing or invalid
+    bool importPrelinkState(const std::vector<uint8_t>& state,
+                            const std::vector<std::size_t>& relocationSectionIndexes);
+    // Runs the checks of compileRelocationPlan on an imported plan, which is applied without any further check
+    bool isImportedRelocationPlanValid(const RelocationPlan& plan,
+                                       const std::vector<std::size_t>& relocationSectionIndexes) const;
+    void checkRuntimeSymTabs() const;
     void updateSharedBuffers(const std::vector<std::size_t>& relocationSectionIndexes);
     void loadBuffers();
+    void allocateArenaBuffers();
+    void allocateSegmentBuffers();
+    void runLoadPipeline(const std::vector<size_t>& loadedSections);
+    std::shared_ptr<ManagedBuffer> getDeduplicatedSectionBuffer(size_t sectionIndex);
+    bool isStreamedSection(size_t sectionIndex) const;
+    // Reads the section chunk by chunk on a reader thread, double-buffered, and passes each chunk in order to
+    // consumeChunk on the calling thread
+    void streamSection(size_t sectionIndex,
+                       const std::function<void(size_t offset, const uint8_t* data, size_t count)>& consumeChunk) const;
+    std::shared_ptr<ManagedBuffer> buildStreamedSectionBuffer(size_t sectionIndex);
     void reloadNewBuffers();
+    // Restores the given sections from their backups (or the AccessManager), submitting all the uploads at once
+    void reloadBuffers(const std::vector<size_t>& sectionIndexes);
+    // Sections restored from their backup (or the AccessManager) by reloadNewBuffers
+    std::vector<size_t> getReloadedSections() const;
+    // Buffers touched by reloading the given sections and applying the given relocation sections, to be locked at once
+    std::vector<ManagedBuffer*> getWorkingSet(const std::vector<size_t>& reloadedSections,
+                                              const std::vector<std::size_t>& relocationSectionIndexes);
+    void buildRebaseSites();
+    void applyJitRelocations(const std::vector<std::size_t>& jitRelocationSectionIndexes,
+                             std::vector<DeviceBuffer>& inputs, std::vector<DeviceBuffer>& outputs,
+                             std::vector<DeviceBuffer>& profiling);
+    void resolveSymbolTables(const std::vector<std::size_t>& relocationSectionIndexes);
+    // Resolves a single symbol table into m_resolvedSymbolTables, unless it is already resolved
+    void resolveSymbolTable(elf::Elf_Word symTabIdx);
+    // Returns false if the symbol has no address, i.e. no runtime symbol matches the type of its section
+    bool resolveSymbol(elf::SymbolEntry& symbol);
+    // Profiling elision is enabled and the section is flagged VPU_SHF_PROFOUTPUT, whatever its type: the profiling
+    // output buffers, but also the symbol tables and the JIT relocation sections of the profiling pointers
+    bool hasElidedProfOutputFlag(size_t sectionIndex) const;
+    // Derives the placement hints of every section from its flags and from the relocation sections targeting it
+    void computePlacementHints();
+    BufferSpecs getSectionBufferSpecs(size_t sectionIndex) const;
+    // the copy constructors check the budget of a copy before copying the members, see CopyBudgetChecked
+    CopyBudgetChecked checkCopyMemoryBudget() const;
+    void updatePeakMemoryUsage();
     void applyRelocations(const std::vector<std::size_t>& relocationSectionIndexes);
 
     BufferManager* m_bufferManager;
+    AccessManager* m_accessor;
+    std::shared_ptr<AccessManager> m_ownedAccessor;
     std::shared_ptr<Reader<ELF_Bitness::Elf64>> m_reader;
     DeviceBufferContainer m_inferBufferContainer;
     DeviceBufferContainer m_backupBufferContainer;
     std::vector<SymbolEntry> m_runtimeSymTabs;
 
+    // Symbol tables with final symbol values (section address + st_value or the runtime symbol substitute)
+    // Rebuilt by resolveSymbolTables() every time the addresses of the sections change
+    std::map<elf::Elf_Word /*symtab section index*/, std::vector<SymbolEntry>> m_resolvedSymbolTables;
+
+    std::shared_ptr<const RelocationPlan> m_relocationPlan;
     std::shared_ptr<std::vector<std::size_t>> m_relocationSectionIndexes;
     std::shared_ptr<std::vector<std::size_t>> m_jitRelocations;
 
@@ -111,7 +355,30 @@ private:
     std::vector<elf::Elf_Word> m_symbolSectionTypes;
 
     bool m_inferencesMayBeRunInParallel;
+    bool m_arenaAllocations = false;
+    bool m_segmentAllocations = false;
+    bool m_backupFreeReload = false;
+    bool m_profilingElision = false;
+    uint64_t m_profilingDummyAddress = 0;
+    bool m_pipelinedLoad = false;
+    size_t m_maxSectionsInFlight = DEFAULT_MAX_SECTIONS_IN_FLIGHT;
+    bool m_sharedSectionDeduplication = false;
+    bool m_streamingUpload = false;
+    size_t m_streamingChunkSize = DEFAULT_STREAMING_CHUNK_SIZE;
+    int m_numaNode = numa::NO_NUMA_NODE;
+    MemoryBudget m_memoryBudget;
+    MemoryUsage m_peakMemoryUsage;
     std::vector<size_t> m_sharedScratchBuffers;
+    std::vector<PlacementHints> m_placementHints;
+
+    // Built on the first moveBuffers call
+    std::shared_ptr<std::map<size_t /*symbol section index*/, RebaseSites>> m_rebaseSites;
+
+    // User IO of the last applyJitRelocations call, needed to relocate again the sections restored by moveBuffers
+    bool m_jitRelocationsApplied = false;
+    std::vector<DeviceBuffer> m_jitInputs;
+    std::vector<DeviceBuffer> m_jitOutputs;
+    std::vector<DeviceBuffer> m_jitProfiling;
 };
 
 }  // namespace elf
@@ -0,0 +1,271 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#include <vpux_elf/utils/error.hpp>
+#include <vpux_elf/utils/log.hpp>
+#include <vpux_elf/utils/utils.hpp>
+#include <vpux_headers/caching_buffer_manager.hpp>
+
+namespace elf {
+
+namespace {
+
+// The buffer handed out to the user keeps the requested size, but follows the cpu_addr of its allocation
+void syncBuffer(DeviceBuffer& devAddress, DeviceBuffer& allocation) {
+    devAddress = DeviceBuffer(allocation.cpu_addr(), allocation.vpu_addr(), devAddress.size());
+}
+
+}  // namespace
+
+CachingBufferManager::CachingBufferManager(BufferManager* bufferManager, size_t maxCachedSize)
+        : mBufferManager(bufferManager), mMaxCachedSize(maxCachedSize) {
+    VPUX_ELF_THROW_UNLESS(mBufferManager, ArgsError, "nullptr BufferManager");
+}
+
+CachingBufferManager::~CachingBufferManager() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mLiveBuffers.empty()) {
+        VPUX_ELF_LOG(LogLevel::LOG_ERROR, "%zu buffers still allocated when destroying the CachingBufferManager",
+                     mLiveBuffers.size());
+    }
+    trimLocked(0);
+}
+
+size_t CachingBufferManager::getSizeClass(size_t size) {
+    if (size <= MIN_SIZE_CLASS) {
+        return MIN_SIZE_CLASS;
+    }
+
+    // 4 size classes per power of two
+    size_t powerOfTwo = MIN_SIZE_CLASS;
+    while (powerOfTwo <= (size - 1) / 2) {
+        powerOfTwo *= 2;
+    }
+    return utils::alignUp(size, powerOfTwo / 4);
+}
+
+DeviceBuffer CachingBufferManager::allocate(const BufferSpecs& buffSpecs) {
+    if (buffSpecs.isSharable()) {
+        return mBufferManager->allocate(buffSpecs);
+    }
+
+    const auto sizeClass = getSizeClass(buffSpecs.size);
+    const FreeListKey key{sizeClass, buffSpecs.alignment, buffSpecs.procFlags, buffSpecs.placementHints};
+
+    DeviceBuffer allocation;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto freeList = mFreeLists.find(key);
+        if (freeList != mFreeLists.end()) {
+            auto cachedBuffer = freeList->second.back();
+            freeList->second.pop_back();
+            if (freeList->second.empty()) {
+                mFreeLists.erase(freeList);
+            }
+
+            allocation = cachedBuffer->buffer;
+            mCachedBuffers.erase(cachedBuffer);
+            mStats.cachedSize -= sizeClass;
+            --mStats.cachedBuffers;
+            ++mStats.hits;
+
+            mLiveBuffers[allocation.vpu_addr()] = {key, allocation};
+            return DeviceBuffer(allocation.cpu_addr(), allocation.vpu_addr(), buffSpecs.size);
+        }
+    }
+
+    allocation = mBufferManager->allocate(
+            BufferSpecs(buffSpecs.alignment, sizeClass, buffSpecs.procFlags, buffSpecs.placementHints));
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    ++mStats.misses;
+    if (!allocation.vpu_addr()) {
+        return allocation;
+    }
+    auto inserted = mLiveBuffers.emplace(allocation.vpu_addr(), CachedBuffer{key, allocation}).second;
+    if (!inserted) {
+        mBufferManager->deallocate(allocation);
+        VPUX_ELF_THROW(RuntimeError, "Underlying BufferManager returned a vpu_addr already in use");
+    }
+    return DeviceBuffer(allocation.cpu_addr(), allocation.vpu_addr(), buffSpecs.size);
+}
+
+void CachingBufferManager::deallocate(DeviceBuffer& devAddress) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    auto liveBuffer = devAddress.vpu_addr() ? mLiveBuffers.find(devAddress.vpu_addr()) : mLiveBuffers.end();
+    if (liveBuffer == mLiveBuffers.end()) {
+        lock.unlock();
+        mBufferManager->deallocate(devAddress);
+        return;
+    }
+
+    auto cachedBuffer = liveBuffer->second;
+    mLiveBuffers.erase(liveBuffer);
+    devAddress = DeviceBuffer();
+
+    const auto sizeClass = std::get<0>(cachedBuffer.key);
+    if (sizeClass > mMaxCachedSize) {
+        ++mStats.trimmedBuffers;
+        mBufferManager->deallocate(cachedBuffer.buffer);
+        return;
+    }
+
+    trimLocked(mMaxCachedSize - sizeClass);
+    auto key = cachedBuffer.key;
+    mCachedBuffers.push_back(std::move(cachedBuffer));
+    mFreeLists[key].push_back(std::prev(mCachedBuffers.end()));
+    mStats.cachedSize += sizeClass;
+    ++mStats.cachedBuffers;
+}
+
+bool CachingBufferManager::findAllocation(const DeviceBuffer& devAddress, DeviceBuffer& allocation) const {
+    // copied under the lock, as a concurrent deallocate may erase the live buffer while the call is forwarded
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto liveBuffer = devAddress.vpu_addr() ? mLiveBuffers.find(devAddress.vpu_addr()) : mLiveBuffers.end();
+    if (liveBuffer == mLiveBuffers.end()) {
+        return false;
+    }
+    allocation = liveBuffer->second.buffer;
+    return true;
+}
+
+void CachingBufferManager::updateAllocation(const DeviceBuffer& allocation) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto liveBuffer = mLiveBuffers.find(allocation.vpu_addr());
+    if (liveBuffer != mLiveBuffers.end()) {
+        liveBuffer->second.buffer = allocation;
+    }
+}
+
+void CachingBufferManager::lock(DeviceBuffer& devAddress) {
+    DeviceBuffer allocation;
+    if (!findAllocation(devAddress, allocation)) {
+        mBufferManager->lock(devAddress);
+        return;
+    }
+
+    mBufferManager->lock(allocation);
+    updateAllocation(allocation);
+    syncBuffer(devAddress, allocation);
+}
+
+void CachingBufferManager::unlock(DeviceBuffer& devAddress) {
+    DeviceBuffer allocation;
+    if (!findAllocation(devAddress, allocation)) {
+        mBufferManager->unlock(devAddress);
+        return;
+    }
+
+    mBufferManager->unlock(allocation);
+    updateAllocation(allocation);
+    syncBuffer(devAddress, allocation);
+}
+
+void CachingBufferManager::lockMany(const std::vector<DeviceBuffer*>& devAddresses) {
+    std::vector<DeviceBuffer> allocations(devAddresses.size());
+    std::vector<DeviceBuffer*> lockedBuffers;
+    lockedBuffers.reserve(devAddresses.size());
+    for (size_t bufferIdx = 0; bufferIdx < devAddresses.size(); ++bufferIdx) {
+        const auto tracked = findAllocation(*devAddresses[bufferIdx], allocations[bufferIdx]);
+        lockedBuffers.push_back(tracked ? &allocations[bufferIdx] : devAddresses[bufferIdx]);
+    }
+
+    mBufferManager->lockMany(lockedBuffers);
+    for (size_t bufferIdx = 0; bufferIdx < devAddresses.size(); ++bufferIdx) {
+        if (lockedBuffers[bufferIdx] == &allocations[bufferIdx]) {
+            updateAllocation(allocations[bufferIdx]);
+            syncBuffer(*devAddresses[bufferIdx], allocations[bufferIdx]);
+        }
+    }
+}
+
+void CachingBufferManager::unlockMany(const std::vector<DeviceBuffer*>& devAddresses) {
+    std::vector<DeviceBuffer> allocations(devAddresses.size());
+    std::vector<DeviceBuffer*> unlockedBuffers;
+    unlockedBuffers.reserve(devAddresses.size());
+    for (size_t bufferIdx = 0; bufferIdx < devAddresses.size(); ++bufferIdx) {
+        const auto tracked = findAllocation(*devAddresses[bufferIdx], allocations[bufferIdx]);
+        unlockedBuffers.push_back(tracked ? &allocations[bufferIdx] : devAddresses[bufferIdx]);
+    }
+
+    mBufferManager->unlockMany(unlockedBuffers);
+    for (size_t bufferIdx = 0; bufferIdx < devAddresses.size(); ++bufferIdx) {
+        if (unlockedBuffers[bufferIdx] == &allocations[bufferIdx]) {
+            updateAllocation(allocations[bufferIdx]);
+            syncBuffer(*devAddresses[bufferIdx], allocations[bufferIdx]);
+        }
+    }
+}
+
+size_t CachingBufferManager::copy(DeviceBuffer& to, const uint8_t* from, size_t count) {
+    VPUX_ELF_THROW_WHEN(count > to.size(), ArgsError, "Copy larger than the DeviceBuffer");
+    DeviceBuffer allocation;
+    return mBufferManager->copy(findAllocation(to, allocation) ? allocation : to, from, count);
+}
+
+size_t CachingBufferManager::copyv(const std::vector<BufferCopy>& copies) {
+    std::vector<DeviceBuffer> allocations(copies.size());
+    std::vector<BufferCopy> allocationCopies;
+    allocationCopies.reserve(copies.size());
+    for (size_t copyIdx = 0; copyIdx < copies.size(); ++copyIdx) {
+        const auto& bufferCopy = copies[copyIdx];
+        VPUX_ELF_THROW_WHEN(bufferCopy.offset > bufferCopy.to->size() ||
+                                    bufferCopy.count > bufferCopy.to->size() - bufferCopy.offset,
+                            ArgsError, "Copy outside of the DeviceBuffer");
+        auto to = findAllocation(*bufferCopy.to, allocations[copyIdx]) ? &allocations[copyIdx] : bufferCopy.to;
+        allocationCopies.push_back({to, bufferCopy.from, bufferCopy.count, bufferCopy.offset});
+    }
+    return mBufferManager->copyv(allocationCopies);
+}
+
+size_t CachingBufferManager::copyAt(DeviceBuffer& to, size_t offset, const uint8_t* from, size_t count) {
+    VPUX_ELF_THROW_WHEN(offset > to.size() || count > to.size() - offset, ArgsError,
+                        "Copy outside of the DeviceBuffer");
+    DeviceBuffer allocation;
+    return mBufferManager->copyAt(findAllocation(to, allocation) ? allocation : to, offset, from, count);
+}
+
+void CachingBufferManager::trim(size_t maxCachedSize) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    trimLocked(maxCachedSize);
+}
+
+void CachingBufferManager::setMaxCachedSize(size_t maxCachedSize) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMaxCachedSize = maxCachedSize;
+    trimLocked(mMaxCachedSize);
+}
+
+size_t CachingBufferManager::getMaxCachedSize() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMaxCachedSize;
+}
+
+CachingBufferManager::CacheStats CachingBufferManager::getCacheStats() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mStats;
+}
+
+void CachingBufferManager::trimLocked(size_t maxCachedSize) {
+    while (mStats.cachedSize > maxCachedSize) {
+        auto& cachedBuffer = mCachedBuffers.front();
+        const auto sizeClass = std::get<0>(cachedBuffer.key);
+
+        // the oldest buffer overall is also the oldest one of its free list
+        auto freeList = mFreeLists.find(cachedBuffer.key);
+        freeList->second.pop_front();
+        if (freeList->second.empty()) {
+            mFreeLists.erase(freeList);
+        }
+
+        mBufferManager->deallocate(cachedBuffer.buffer);
+        mCachedBuffers.pop_front();
+        mStats.cachedSize -= sizeClass;
+        --mStats.cachedBuffers;
+        ++mStats.trimmedBuffers;
+    }
+}
+
+}  // namespace elf
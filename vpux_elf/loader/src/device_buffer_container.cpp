@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache 2.0
 //
 
+#include <unordered_map>
 #include <utility>
 #include <vpux_headers/device_buffer_container.hpp>
 #include "vpux_elf/utils/error.hpp"
@@ -16,7 +17,7 @@ DeviceBufferContainer::DeviceBufferContainer(BufferManager* bManager): mBufferMa
 DeviceBufferContainer::DeviceBufferContainer(const DeviceBufferContainer& other) {
     VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Copying DeviceBuffer container");
     mBufferManager = other.mBufferManager;
-    copyBufferMap(other.mBufferMap);
+    copyBufferSlots(other);
 }
 
 DeviceBufferContainer& DeviceBufferContainer::operator=(const DeviceBufferContainer& rhs) {
@@ -26,7 +27,7 @@ DeviceBufferContainer& DeviceBufferContainer::operator=(const DeviceBufferContai
 
     VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Copying DeviceBuffer container");
     mBufferManager = rhs.mBufferManager;
-    copyBufferMap(rhs.mBufferMap);
+    copyBufferSlots(rhs);
     return *this;
 }
 
@@ -37,42 +38,71 @@ DeviceBufferContainer::BufferPtr DeviceBufferContainer::buildAllocatedDeviceBuff
 DeviceBufferContainer::BufferInfo& DeviceBufferContainer::safeInitBufferInfoAtIndex(size_t index) {
     VPUX_ELF_THROW_WHEN(hasBufferInfoAtIndex(index), RuntimeError, "BufferInfo already exists at requested index");
 
-    return mBufferMap[index] = {};
+    if (index >= mBufferSlots.size()) {
+        mBufferSlots.resize(index + 1);
+        mPresent.resize(index + 1, false);
+    }
+
+    mPresent[index] = true;
+    ++mBufferInfoCount;
+    mBufferSlots[index] = {index, {}};
+    return mBufferSlots[index].second;
 }
 
 DeviceBufferContainer::BufferInfo& DeviceBufferContainer::getBufferInfoFromIndex(size_t index) {
-    return mBufferMap.at(index);
+    VPUX_ELF_THROW_UNLESS(hasBufferInfoAtIndex(index), RangeError, "No BufferInfo at requested index");
+    return mBufferSlots[index].second;
 }
 
-bool DeviceBufferContainer::hasBufferInfoAtIndex(size_t index) {
-    return (mBufferMap.find(index) != mBufferMap.end());
+bool DeviceBufferContainer::hasBufferInfoAtIndex(size_t index) const {
+    return index < mPresent.size() && mPresent[index];
 }
 
-size_t DeviceBufferContainer::getBufferInfoCount() {
-    return mBufferMap.size();
+size_t DeviceBufferContainer::getBufferInfoCount() const {
+    return mBufferInfoCount;
 }
 
 std::vector<DeviceBuffer> DeviceBufferContainer::getBuffersAsVector() const {
     std::vector<DeviceBuffer> devBuffersVector;
-    devBuffersVector.reserve(mBufferMap.size());
-    for (const auto& buffer : mBufferMap) {
+    devBuffersVector.reserve(mBufferInfoCount);
+    for (const auto& buffer : *this) {
         devBuffersVector.push_back((buffer.second).mBuffer->getBuffer());
     }
     return devBuffersVector;
 }
 
-void DeviceBufferContainer::copyBufferMap(const BufferMap& otherBufferMap) {
-    VPUX_ELF_THROW_WHEN(&otherBufferMap == &mBufferMap, RuntimeError, "Cloning self map");
-    for (auto& it : otherBufferMap) {
+void DeviceBufferContainer::copyBufferSlots(const DeviceBufferContainer& other) {
+    VPUX_ELF_THROW_WHEN(&other == this, RuntimeError, "Cloning self map");
+
+    // slots are sized once, then the buffers are created in section order
+    mBufferSlots.clear();
+    mBufferSlots.resize(other.mBufferSlots.size());
+    mPresent = other.mPresent;
+    mBufferInfoCount = other.mBufferInfoCount;
+
+    // views of the same arena are recreated inside a single new arena
+    std::unordered_map<const DeviceBufferArena*, std::shared_ptr<DeviceBufferArena>> newArenas;
+
+    for (const auto& it : other) {
         auto& index = it.first;
         auto& bufferInfo = it.second;
         if (bufferInfo.mBufferDetails.mIsShared) {
-            mBufferMap[index] = bufferInfo;
+            mBufferSlots[index] = it;
+        } else if (auto view = dynamic_cast<const ArenaBufferView*>(bufferInfo.mBuffer.get())) {
+            auto& newArena = newArenas[view->getArena().get()];
+            if (!newArena) {
+                newArena = view->getArena()->createNew();
+            }
+
+            BufferInfo newBufferInfo;
+            newBufferInfo.mBuffer = view->createNewInArena(newArena);
+            newBufferInfo.mBufferDetails = bufferInfo.mBufferDetails;
+            mBufferSlots[index] = {index, newBufferInfo};
         } else {
             BufferInfo newBufferInfo;
             newBufferInfo.mBuffer = bufferInfo.mBuffer->createNew();
             newBufferInfo.mBufferDetails = bufferInfo.mBufferDetails;
-            mBufferMap[index] = newBufferInfo;
+            mBufferSlots[index] = {index, newBufferInfo};
         }
     }
 }
@@ -0,0 +1,268 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include <vpux_elf/utils/error.hpp>
+#include <vpux_elf/utils/log.hpp>
+#include <vpux_elf/utils/utils.hpp>
+#include <vpux_headers/host_allocator.hpp>
+#include <vpux_headers/numa.hpp>
+
+namespace elf {
+
+const char* stringifyHostAllocationPolicy(HostAllocationPolicy policy) {
+    switch (policy) {
+    case HostAllocationPolicy::ALIGNED_NEW:
+        return "aligned new";
+    case HostAllocationPolicy::HUGE_PAGES:
+        return "huge pages";
+    case HostAllocationPolicy::USER_CALLBACK:
+        return "user callback";
+    case HostAllocationPolicy::MONOTONIC_ARENA:
+        return "monotonic arena";
+    case HostAllocationPolicy::NUMA_NODE:
+        return "NUMA node";
+    default:
+        return "unknown";
+    }
+}
+
+const std::shared_ptr<HostAllocator>& HostAllocator::getDefault() {
+    static const std::shared_ptr<HostAllocator> defaultAllocator = std::make_shared<AlignedHostAllocator>();
+    return defaultAllocator;
+}
+
+HostAllocation AlignedHostAllocator::allocate(size_t size, size_t alignment) {
+    VPUX_ELF_THROW_UNLESS(utils::isPowerOfTwo(alignment), ArgsError, "Requested alignment is not a power of 2");
+    HostAllocation allocation;
+    allocation.ptr = ::operator new(size, std::align_val_t(alignment));
+    allocation.size = size;
+    allocation.alignment = alignment;
+    allocation.policy = HostAllocationPolicy::ALIGNED_NEW;
+    return allocation;
+}
+
+void AlignedHostAllocator::deallocate(const HostAllocation& allocation) {
+    ::operator delete(allocation.ptr, std::align_val_t(allocation.alignment));
+}
+
+HugePageHostAllocator::HugePageHostAllocator(size_t minHugePageSize): mMinHugePageSize(minHugePageSize) {
+}
+
+HostAllocation HugePageHostAllocator::allocate(size_t size, size_t alignment) {
+    VPUX_ELF_THROW_UNLESS(utils::isPowerOfTwo(alignment), ArgsError, "Requested alignment is not a power of 2");
+#if defined(__linux__)
+    if (size >= mMinHugePageSize && alignment <= HUGE_PAGE_SIZE) {
+        // over-map by a huge page to be able to trim the mapping to huge page boundaries
+        const auto mappedSize = utils::alignUp(size, HUGE_PAGE_SIZE);
+        const auto reservedSize = mappedSize + HUGE_PAGE_SIZE;
+        auto reserved = mmap(nullptr, reservedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved != MAP_FAILED) {
+            const auto reservedBase = reinterpret_cast<uintptr_t>(reserved);
+            const auto mappedBase = utils::alignUp(reservedBase, HUGE_PAGE_SIZE);
+            if (mappedBase > reservedBase) {
+                munmap(reserved, mappedBase - reservedBase);
+            }
+            if (reservedBase + reservedSize > mappedBase + mappedSize) {
+                munmap(reinterpret_cast<void*>(mappedBase + mappedSize),
+                       reservedBase + reservedSize - mappedBase - mappedSize);
+            }
+
+            auto mapped = reinterpret_cast<void*>(mappedBase);
+            if (madvise(mapped, mappedSize, MADV_HUGEPAGE)) {
+                VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "MADV_HUGEPAGE not supported, using regular pages");
+            }
+
+            HostAllocation allocation;
+            allocation.ptr = mapped;
+            allocation.size = mappedSize;
+            allocation.alignment = HUGE_PAGE_SIZE;
+            allocation.policy = HostAllocationPolicy::HUGE_PAGES;
+            return allocation;
+        }
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "Failed to map %zu bytes, falling back to aligned new", size);
+    }
+#endif
+    return mFallback.allocate(size, alignment);
+}
+
+void HugePageHostAllocator::deallocate(const HostAllocation& allocation) {
+#if defined(__linux__)
+    if (allocation.policy == HostAllocationPolicy::HUGE_PAGES) {
+        munmap(allocation.ptr, allocation.size);
+        return;
+    }
+#endif
+    mFallback.deallocate(allocation);
+}
+
+NumaHostAllocator::NumaHostAllocator(int numaNode, size_t minNumaSize)
+        : mNumaNode(numaNode), mMinNumaSize(minNumaSize), mNodeAvailable(numa::isNodeAvailable(numaNode)) {
+    if (mNumaNode != numa::NO_NUMA_NODE && !mNodeAvailable) {
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "NUMA node %d is not available, falling back to aligned new", mNumaNode);
+    }
+}
+
+HostAllocation NumaHostAllocator::allocate(size_t size, size_t alignment) {
+    VPUX_ELF_THROW_UNLESS(utils::isPowerOfTwo(alignment), ArgsError, "Requested alignment is not a power of 2");
+#if defined(__linux__)
+    if (mNodeAvailable && size && size >= mMinNumaSize && alignment <= PAGE_SIZE) {
+        const auto mappedSize = utils::alignUp(size, PAGE_SIZE);
+        auto mapped = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped != MAP_FAILED) {
+            // the pages are not touched yet, so they are placed by the policy on first access
+            if (!numa::bindMemoryToNode(mapped, mappedSize, mNumaNode)) {
+                VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "Failed to bind %zu bytes to NUMA node %d", mappedSize, mNumaNode);
+            }
+
+            HostAllocation allocation;
+            allocation.ptr = mapped;
+            allocation.size = mappedSize;
+            allocation.alignment = PAGE_SIZE;
+            allocation.policy = HostAllocationPolicy::NUMA_NODE;
+            return allocation;
+        }
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "Failed to map %zu bytes, falling back to aligned new", size);
+    }
+#endif
+    return mFallback.allocate(size, alignment);
+}
+
+void NumaHostAllocator::deallocate(const HostAllocation& allocation) {
+#if defined(__linux__)
+    if (allocation.policy == HostAllocationPolicy::NUMA_NODE) {
+        munmap(allocation.ptr, allocation.size);
+        return;
+    }
+#endif
+    mFallback.deallocate(allocation);
+}
+
+int NumaHostAllocator::getNumaNode() const {
+    return mNumaNode;
+}
+
+CallbackHostAllocator::CallbackHostAllocator(AllocateCallback allocateCallback, DeallocateCallback deallocateCallback)
+        : mAllocateCallback(std::move(allocateCallback)), mDeallocateCallback(std::move(deallocateCallback)) {
+    VPUX_ELF_THROW_UNLESS(mAllocateCallback && mDeallocateCallback, ArgsError, "Empty host allocation callback");
+}
+
+HostAllocation CallbackHostAllocator::allocate(size_t size, size_t alignment) {
+    HostAllocation allocation;
+    allocation.ptr = mAllocateCallback(size, alignment);
+    VPUX_ELF_THROW_UNLESS(allocation.ptr, AllocError, "Host allocation callback failed");
+    VPUX_ELF_THROW_WHEN(reinterpret_cast<uintptr_t>(allocation.ptr) & (alignment - 1), AllocError,
+                        "Host allocation callback returned misaligned memory");
+    allocation.size = size;
+    allocation.alignment = alignment;
+    allocation.policy = HostAllocationPolicy::USER_CALLBACK;
+    return allocation;
+}
+
+void CallbackHostAllocator::deallocate(const HostAllocation& allocation) {
+    mDeallocateCallback(allocation.ptr, allocation.size);
+}
+
+MonotonicHostAllocator::MonotonicHostAllocator(size_t blockSize, std::shared_ptr<HostAllocator> blockAllocator)
+        : mBlockSize(blockSize), mBlockAllocator(std::move(blockAllocator)) {
+    VPUX_ELF_THROW_UNLESS(mBlockSize, ArgsError, "Empty arena block size");
+    VPUX_ELF_THROW_UNLESS(mBlockAllocator, ArgsError, "nullptr block HostAllocator");
+}
+
+MonotonicHostAllocator::~MonotonicHostAllocator() {
+    if (mStats.liveAllocations) {
+        VPUX_ELF_LOG(LogLevel::LOG_ERROR, "%zu allocations still live when destroying the MonotonicHostAllocator",
+                     mStats.liveAllocations);
+    }
+    for (const auto& block : mBlocks) {
+        mBlockAllocator->deallocate(block.allocation);
+    }
+}
+
+HostAllocation MonotonicHostAllocator::allocate(size_t size, size_t alignment) {
+    VPUX_ELF_THROW_UNLESS(utils::isPowerOfTwo(alignment), ArgsError, "Requested alignment is not a power of 2");
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    Block* block = nullptr;
+    if (!mBlocks.empty() && alignment <= BLOCK_ALIGNMENT) {
+        auto& carvedBlock = mBlocks.back();
+        const auto offset = utils::alignUp(carvedBlock.offset, alignment);
+        if (offset <= carvedBlock.allocation.size && size <= carvedBlock.allocation.size - offset) {
+            block = &carvedBlock;
+        }
+    }
+
+    if (!block) {
+        Block newBlock;
+        newBlock.allocation =
+                mBlockAllocator->allocate(std::max(size, mBlockSize), std::max(alignment, BLOCK_ALIGNMENT));
+        newBlock.offset = 0;
+        newBlock.dedicated = size > mBlockSize;
+        mStats.reservedSize += newBlock.allocation.size;
+        ++mStats.blocks;
+
+        // dedicated blocks go before the carved one, to keep carving its free space
+        if (newBlock.dedicated && !mBlocks.empty()) {
+            block = &*mBlocks.insert(std::prev(mBlocks.end()), newBlock);
+        } else {
+            mBlocks.push_back(newBlock);
+            block = &mBlocks.back();
+        }
+    }
+
+    const auto offset = utils::alignUp(block->offset, alignment);
+    block->offset = offset + size;
+    mStats.usedSize += size;
+    ++mStats.liveAllocations;
+
+    HostAllocation allocation;
+    allocation.ptr = static_cast<uint8_t*>(block->allocation.ptr) + offset;
+    allocation.size = size;
+    allocation.alignment = alignment;
+    allocation.policy = HostAllocationPolicy::MONOTONIC_ARENA;
+    return allocation;
+}
+
+void MonotonicHostAllocator::deallocate(const HostAllocation&) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    VPUX_ELF_THROW_UNLESS(mStats.liveAllocations, SequenceError, "Deallocation without a live arena allocation");
+    if (!--mStats.liveAllocations) {
+        releaseLocked();
+    }
+}
+
+MonotonicHostAllocator::ArenaStats MonotonicHostAllocator::getArenaStats() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mStats;
+}
+
+void MonotonicHostAllocator::releaseLocked() {
+    mStats.blocks = 0;
+    mStats.reservedSize = 0;
+    mStats.usedSize = 0;
+
+    // keep the carved block for the next load, unless it is a dedicated one
+    const auto keepLast = !mBlocks.empty() && !mBlocks.back().dedicated;
+    for (size_t blockIdx = 0; blockIdx + (keepLast ? 1 : 0) < mBlocks.size(); ++blockIdx) {
+        mBlockAllocator->deallocate(mBlocks[blockIdx].allocation);
+    }
+    mBlocks.erase(mBlocks.begin(), keepLast ? std::prev(mBlocks.end()) : mBlocks.end());
+
+    if (keepLast) {
+        mBlocks.front().offset = 0;
+        mStats.blocks = 1;
+        mStats.reservedSize = mBlocks.front().allocation.size;
+    }
+}
+
+}  // namespace elf
@@ -3,11 +3,16 @@
 // SPDX-License-Identifier: Apache 2.0
 //
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <exception>
+#include <iterator>
 #include <memory>
 #include <vector>
 
 #include <vpux_elf/utils/error.hpp>
+#include <vpux_elf/utils/log.hpp>
 #include <vpux_elf/utils/utils.hpp>
 #include <vpux_headers/managed_buffer.hpp>
 #include "vpux_headers/device_buffer.hpp"
@@ -16,6 +21,19 @@ namespace elf {
 
 static_assert(sizeof(size_t) >= sizeof(uintptr_t), "");
 
+namespace {
+
+// Decrements a lock count, unless it is already 0. Returns the decremented count
+size_t decrementLockCount(std::atomic<size_t>& lockCount) {
+    auto count = lockCount.load();
+    do {
+        VPUX_ELF_THROW_WHEN(count == 0, SequenceError, "Unlocking a buffer that is not locked");
+    } while (!lockCount.compare_exchange_weak(count, count - 1));
+    return count - 1;
+}
+
+}  // namespace
+
 ManagedBuffer::ManagedBuffer(BufferSpecs bSpecs): mDevBuffer(), mBufferSpecs(bSpecs), mUserPrivateData(nullptr) {
 }
 
@@ -32,9 +50,17 @@ BufferSpecs ManagedBuffer::getBufferSpecs() const {
 }
 
 void ManagedBuffer::lock() {
+    auto request = acquireLock();
+    if (request.manager) {
+        request.manager->lock(*request.buffer);
+    }
 }
 
 void ManagedBuffer::unlock() {
+    auto request = releaseLock();
+    if (request.manager) {
+        request.manager->unlock(*request.buffer);
+    }
 }
 
 void ManagedBuffer::load(const uint8_t* from, size_t count) {
@@ -47,6 +73,56 @@ void ManagedBuffer::loadWithLock(const uint8_t* from, size_t count) {
     unlock();
 }
 
+void ManagedBuffer::loadAt(size_t offset, const uint8_t* from, size_t count) {
+    VPUX_ELF_THROW_WHEN(offset > mDevBuffer.size() || count > mDevBuffer.size() - offset, RangeError,
+                        "Load outside of the buffer");
+    std::memcpy(mDevBuffer.cpu_addr() + offset, from, count);
+}
+
+size_t ManagedBuffer::getOwnedSize() const {
+    return mBufferSpecs.size;
+}
+
+ManagedBuffer::LockRequest ManagedBuffer::acquireLock() {
+    ++mLockCount;
+    return {};
+}
+
+ManagedBuffer::LockRequest ManagedBuffer::releaseLock() {
+    decrementLockCount(mLockCount);
+    return {};
+}
+
+ManagedBuffer::CopyTarget ManagedBuffer::getCopyTarget() {
+    return {};
+}
+
+void ManagedBuffer::loadMany(const std::vector<LoadRequest>& loads) {
+    std::vector<std::pair<BufferManager*, std::vector<BufferCopy>>> copies;
+    for (const auto& load : loads) {
+        VPUX_ELF_THROW_UNLESS(load.buffer, ArgsError, "nullptr ManagedBuffer");
+        auto target = load.buffer->getCopyTarget();
+        if (!target.manager) {
+            load.buffer->load(load.from, load.count);
+            continue;
+        }
+
+        auto managerCopies = std::find_if(copies.begin(), copies.end(), [&](const auto& elem) {
+            return elem.first == target.manager;
+        });
+        if (managerCopies == copies.end()) {
+            copies.emplace_back(target.manager, std::vector<BufferCopy>());
+            managerCopies = std::prev(copies.end());
+        }
+        VPUX_ELF_THROW_WHEN(load.count > load.buffer->getBufferSpecs().size, RangeError, "Load outside of the buffer");
+        managerCopies->second.push_back({target.buffer, load.from, load.count, target.offset});
+    }
+
+    for (const auto& managerCopies : copies) {
+        managerCopies.first->copyv(managerCopies.second);
+    }
+}
+
 AllocatedDeviceBuffer::AllocatedDeviceBuffer(BufferManager* bManager, BufferSpecs bSpecs)
         : ManagedBuffer(bSpecs), mBufferManager(bManager) {
     VPUX_ELF_THROW_UNLESS(bManager, ArgsError, "nullptr BufferManager");
@@ -60,47 +136,80 @@ AllocatedDeviceBuffer::~AllocatedDeviceBuffer() {
     mBufferManager = nullptr;
 }
 
+void AllocatedDeviceBuffer::replaceAllocation(const DeviceBuffer& newBuffer) {
+    VPUX_ELF_THROW_WHEN(mLockCount, SequenceError, "Replacing the allocation of a locked buffer");
+    mBufferManager->deallocate(mDevBuffer);
+    mDevBuffer = newBuffer;
+}
+
 std::unique_ptr<ManagedBuffer> AllocatedDeviceBuffer::createNew() const {
     return std::make_unique<AllocatedDeviceBuffer>(mBufferManager, mBufferSpecs);
 }
 
-void AllocatedDeviceBuffer::lock() {
-    mBufferManager->lock(mDevBuffer);
+void AllocatedDeviceBuffer::load(const uint8_t* from, size_t count) {
+    mBufferManager->copy(mDevBuffer, from, count);
 }
 
-void AllocatedDeviceBuffer::unlock() {
-    mBufferManager->unlock(mDevBuffer);
+void AllocatedDeviceBuffer::loadAt(size_t offset, const uint8_t* from, size_t count) {
+    mBufferManager->copyAt(mDevBuffer, offset, from, count);
 }
 
-void AllocatedDeviceBuffer::load(const uint8_t* from, size_t count) {
-    mBufferManager->copy(mDevBuffer, from, count);
+ManagedBuffer::LockRequest AllocatedDeviceBuffer::acquireLock() {
+    if (mLockCount++ == 0) {
+        return {mBufferManager, &mDevBuffer};
+    }
+    return {};
 }
 
-DynamicBuffer::DynamicBuffer(BufferSpecs bSpecs): ManagedBuffer(bSpecs) {
+ManagedBuffer::LockRequest AllocatedDeviceBuffer::releaseLock() {
+    if (decrementLockCount(mLockCount) == 0) {
+        return {mBufferManager, &mDevBuffer};
+    }
+    return {};
+}
+
+ManagedBuffer::CopyTarget AllocatedDeviceBuffer::getCopyTarget() {
+    return {mBufferManager, &mDevBuffer};
+}
+
+DynamicBuffer::DynamicBuffer(BufferSpecs bSpecs, std::shared_ptr<HostAllocator> hostAllocator)
+        : ManagedBuffer(bSpecs), mHostAllocator(std::move(hostAllocator)) {
+    VPUX_ELF_THROW_UNLESS(mHostAllocator, ArgsError, "nullptr HostAllocator");
     VPUX_ELF_THROW_UNLESS(utils::isPowerOfTwo(mDefaultSafeAlignment), RuntimeError,
                           "Default safe alignment is not a power of 2");
     VPUX_ELF_THROW_UNLESS(utils::isPowerOfTwo(bSpecs.alignment), RuntimeError,
                         "Requested alignment is not a power of 2");
 
-    size_t bufferSize, bufferAlignment;
-    bSpecs.alignment < mDefaultSafeAlignment ? bufferAlignment = mDefaultSafeAlignment
-                                             : bufferAlignment = bSpecs.alignment;
-    bufferSize = utils::alignUp(bSpecs.size, mDefaultSafeAlignment);
+    const auto bufferAlignment = std::max<size_t>(bSpecs.alignment, mDefaultSafeAlignment);
+    const auto bufferSize = getAllocationSize(bSpecs.size);
 
-    mData.reserve(bufferSize + bufferAlignment);
+    mAllocation = mHostAllocator->allocate(bufferSize, bufferAlignment);
+    VPUX_ELF_THROW_WHEN(!mAllocation.ptr || mAllocation.size < bufferSize, AllocError, "Host allocation failed");
+    VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "DynamicBuffer of %zu bytes served by %s", bufferSize,
+                 stringifyHostAllocationPolicy(mAllocation.policy));
 
-    size_t bufferBase = reinterpret_cast<uintptr_t>(mData.data());
-    size_t bufferBaseAligned = utils::alignUp(bufferBase, bufferAlignment);
+    auto bufferBase = reinterpret_cast<uint8_t*>(mAllocation.ptr);
+    mDevBuffer = DeviceBuffer(bufferBase, reinterpret_cast<uintptr_t>(bufferBase), bSpecs.size);
+}
 
-    VPUX_ELF_THROW_WHEN(bufferBaseAligned < bufferBase, RuntimeError, "Invalid aligned buffer base address");
-    VPUX_ELF_THROW_WHEN((bufferBaseAligned - bufferBase + bSpecs.size) > mData.capacity(), RuntimeError,
-                        "Usable buffer range exceeds parent buffer");
+DynamicBuffer::~DynamicBuffer() {
+    mHostAllocator->deallocate(mAllocation);
+}
 
-    mDevBuffer = DeviceBuffer(reinterpret_cast<uint8_t*>(bufferBaseAligned), bufferBaseAligned, bSpecs.size);
+size_t DynamicBuffer::getAllocationSize(size_t size) {
+    return utils::alignUp(size, mDefaultSafeAlignment);
 }
 
 std::unique_ptr<ManagedBuffer> DynamicBuffer::createNew() const {
-    return std::make_unique<DynamicBuffer>(mBufferSpecs);
+    return std::make_unique<DynamicBuffer>(mBufferSpecs, mHostAllocator);
+}
+
+size_t DynamicBuffer::getOwnedSize() const {
+    return mAllocation.size;
+}
+
+HostAllocationPolicy DynamicBuffer::getHostAllocationPolicy() const {
+    return mAllocation.policy;
 }
 
 StaticBuffer::StaticBuffer(uint8_t* cpuAddr, BufferSpecs bSpecs): ManagedBuffer(bSpecs) {
@@ -125,4 +234,164 @@ std::unique_ptr<ManagedBuffer> StaticBuffer::createNew() const {
     return std::make_unique<DynamicBuffer>(mBufferSpecs);
 }
 
+size_t StaticBuffer::getOwnedSize() const {
+    return 0;
+}
+
+DeviceBufferArena::DeviceBufferArena(BufferManager* bManager, BufferSpecs bSpecs)
+        : mBufferManager(bManager), mBuffer(bManager, bSpecs) {
+}
+
+std::shared_ptr<DeviceBufferArena> DeviceBufferArena::createNew() const {
+    return createNew(mBuffer.getBufferSpecs());
+}
+
+std::shared_ptr<DeviceBufferArena> DeviceBufferArena::createNew(BufferSpecs bSpecs) const {
+    return std::make_shared<DeviceBufferArena>(mBufferManager, bSpecs);
+}
+
+DeviceBuffer DeviceBufferArena::getBuffer() const {
+    return mBuffer.getBuffer();
+}
+
+ManagedBuffer::LockRequest DeviceBufferArena::acquireLock() {
+    return mBuffer.acquireLock();
+}
+
+ManagedBuffer::LockRequest DeviceBufferArena::releaseLock() {
+    return mBuffer.releaseLock();
+}
+
+ManagedBuffer::CopyTarget DeviceBufferArena::getCopyTarget() {
+    return mBuffer.getCopyTarget();
+}
+
+void DeviceBufferArena::load(uint64_t offset, const uint8_t* from, size_t count) {
+    // like any other device buffer, the arena is uploaded through its BufferManager, which may not expose a writable
+    // CPU mapping
+    VPUX_ELF_THROW_WHEN(offset > mBuffer.getBuffer().size() || count > mBuffer.getBuffer().size() - offset, RangeError,
+                        "Load outside of the arena");
+    mBuffer.loadAt(offset, from, count);
+}
+
+ArenaBufferView::ArenaBufferView(std::shared_ptr<DeviceBufferArena> arena, uint64_t offset, BufferSpecs bSpecs)
+        : ManagedBuffer(bSpecs), mArena(std::move(arena)), mOffset(offset) {
+    VPUX_ELF_THROW_UNLESS(mArena, ArgsError, "nullptr DeviceBufferArena");
+    VPUX_ELF_THROW_WHEN(mOffset > mArena->getBuffer().size() || bSpecs.size > mArena->getBuffer().size() - mOffset,
+                        RangeError, "View outside of the arena");
+}
+
+std::unique_ptr<ManagedBuffer> ArenaBufferView::createNew() const {
+    return std::make_unique<ArenaBufferView>(mArena->createNew(mBufferSpecs), 0, mBufferSpecs);
+}
+
+std::unique_ptr<ArenaBufferView> ArenaBufferView::createNewInArena(std::shared_ptr<DeviceBufferArena> arena) const {
+    return std::make_unique<ArenaBufferView>(std::move(arena), mOffset, mBufferSpecs);
+}
+
+const std::shared_ptr<DeviceBufferArena>& ArenaBufferView::getArena() const {
+    return mArena;
+}
+
+DeviceBuffer ArenaBufferView::getBuffer() const {
+    auto arenaBuffer = mArena->getBuffer();
+    return DeviceBuffer(arenaBuffer.cpu_addr() ? arenaBuffer.cpu_addr() + mOffset : nullptr,
+                        arenaBuffer.vpu_addr() + mOffset, mBufferSpecs.size);
+}
+
+void ArenaBufferView::load(const uint8_t* from, size_t count) {
+    // the arena bounds alone would let the load overwrite the next views
+    VPUX_ELF_THROW_WHEN(count > mBufferSpecs.size, RangeError, "Load outside of the buffer");
+    mArena->load(mOffset, from, count);
+}
+
+void ArenaBufferView::loadAt(size_t offset, const uint8_t* from, size_t count) {
+    VPUX_ELF_THROW_WHEN(offset > mBufferSpecs.size || count > mBufferSpecs.size - offset, RangeError,
+                        "Load outside of the buffer");
+    mArena->load(mOffset + offset, from, count);
+}
+
+ManagedBuffer::LockRequest ArenaBufferView::acquireLock() {
+    return mArena->acquireLock();
+}
+
+ManagedBuffer::LockRequest ArenaBufferView::releaseLock() {
+    return mArena->releaseLock();
+}
+
+ManagedBuffer::CopyTarget ArenaBufferView::getCopyTarget() {
+    // the views of an arena are batched as copies into the arena DeviceBuffer
+    auto target = mArena->getCopyTarget();
+    target.offset += mOffset;
+    return target;
+}
+
+namespace {
+
+// Group the lock requests by BufferManager, so that each manager gets a single lockMany/unlockMany call
+using LockRequests = std::vector<std::pair<BufferManager*, std::vector<DeviceBuffer*>>>;
+
+void addLockRequest(LockRequests& requests, const ManagedBuffer::LockRequest& request) {
+    if (!request.manager) {
+        return;
+    }
+
+    auto managerRequests = std::find_if(requests.begin(), requests.end(), [&](const auto& elem) {
+        return elem.first == request.manager;
+    });
+    if (managerRequests == requests.end()) {
+        requests.emplace_back(request.manager, std::vector<DeviceBuffer*>());
+        managerRequests = std::prev(requests.end());
+    }
+    managerRequests->second.push_back(request.buffer);
+}
+
+}  // namespace
+
+ElfBufferBatchLockGuard::ElfBufferBatchLockGuard(const std::vector<ManagedBuffer*>& devBuffers) {
+    mDevBuffers.reserve(devBuffers.size());
+    LockRequests requests;
+    for (auto devBuffer : devBuffers) {
+        if (devBuffer) {
+            mDevBuffers.push_back(devBuffer);
+            addLockRequest(requests, devBuffer->acquireLock());
+        }
+    }
+
+    size_t lockedManagers = 0;
+    try {
+        for (; lockedManagers < requests.size(); ++lockedManagers) {
+            requests[lockedManagers].first->lockMany(requests[lockedManagers].second);
+        }
+    } catch (...) {
+        for (size_t managerIdx = 0; managerIdx < lockedManagers; ++managerIdx) {
+            requests[managerIdx].first->unlockMany(requests[managerIdx].second);
+        }
+        for (auto devBuffer : mDevBuffers) {
+            devBuffer->releaseLock();
+        }
+        throw;
+    }
+}
+
+ElfBufferBatchLockGuard::~ElfBufferBatchLockGuard() {
+    // a failed unlock can't be reported from a destructor, it is logged and the remaining buffers are still unlocked
+    LockRequests requests;
+    for (auto devBuffer : mDevBuffers) {
+        try {
+            addLockRequest(requests, devBuffer->releaseLock());
+        } catch (const std::exception& exception) {
+            VPUX_ELF_LOG(LogLevel::LOG_ERROR, "Failed to release the lock of a buffer: %s", exception.what());
+        }
+    }
+
+    for (const auto& managerRequests : requests) {
+        try {
+            managerRequests.first->unlockMany(managerRequests.second);
+        } catch (const std::exception& exception) {
+            VPUX_ELF_LOG(LogLevel::LOG_ERROR, "Failed to unlock buffers: %s", exception.what());
+        }
+    }
+}
+
 }  // namespace elf
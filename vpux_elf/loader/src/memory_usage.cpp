@@ -0,0 +1,31 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#include <string>
+
+#include <vpux_elf/utils/error.hpp>
+#include <vpux_elf/utils/log.hpp>
+#include <vpux_headers/memory_usage.hpp>
+
+namespace elf {
+
+void MemoryBudget::check(const MemoryUsage& usage, const char* operation) const {
+    if (usage.getDeviceBytes() > deviceBytes) {
+        const auto message = std::string("Memory budget exceeded: ") + operation + " needs " +
+                             std::to_string(usage.getDeviceBytes()) + " device bytes, the budget is " +
+                             std::to_string(deviceBytes);
+        VPUX_ELF_LOG(LogLevel::LOG_ERROR, "%s", message.c_str());
+        VPUX_ELF_THROW(AllocError, message.c_str());
+    }
+    if (usage.getHostBytes() > hostBytes) {
+        const auto message = std::string("Memory budget exceeded: ") + operation + " needs " +
+                             std::to_string(usage.getHostBytes()) + " host bytes, the budget is " +
+                             std::to_string(hostBytes);
+        VPUX_ELF_LOG(LogLevel::LOG_ERROR, "%s", message.c_str());
+        VPUX_ELF_THROW(AllocError, message.c_str());
+    }
+}
+
+}  // namespace elf
@@ -0,0 +1,173 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <vpux_elf/utils/log.hpp>
+#include <vpux_headers/numa.hpp>
+
+namespace elf {
+
+namespace numa {
+
+namespace {
+
+#if defined(__linux__)
+
+// from linux/mempolicy.h, not pulled in to avoid depending on libnuma headers
+constexpr int MPOL_PREFERRED_MODE = 1;
+
+// Parses a sysfs CPU list such as "0-3,8,10-11"
+std::vector<size_t> parseCPUList(const std::string& cpuList) {
+    std::vector<size_t> cpus;
+    size_t pos = 0;
+    while (pos < cpuList.size()) {
+        auto end = cpuList.find(',', pos);
+        if (end == std::string::npos) {
+            end = cpuList.size();
+        }
+
+        const auto range = cpuList.substr(pos, end - pos);
+        const auto dash = range.find('-');
+        try {
+            const size_t first = std::stoul(range.substr(0, dash));
+            const size_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+            for (auto cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            return {};
+        }
+        pos = end + 1;
+    }
+    return cpus;
+}
+
+#endif
+
+}  // namespace
+
+bool isNodeAvailable(int node) {
+    return !getNodeCPUs(node).empty();
+}
+
+std::vector<size_t> getNodeCPUs(int node) {
+#if defined(__linux__)
+    if (node < 0) {
+        return {};
+    }
+
+    // the topology does not change at runtime, sysfs is only read once per node
+    static std::mutex cacheMutex;
+    static std::map<int, std::vector<size_t>> nodeCPUsCache;
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto cachedCPUs = nodeCPUsCache.find(node);
+    if (cachedCPUs != nodeCPUsCache.end()) {
+        return cachedCPUs->second;
+    }
+
+    std::ifstream cpuListFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string cpuList;
+    auto& nodeCPUs = nodeCPUsCache[node];
+    if (std::getline(cpuListFile, cpuList)) {
+        nodeCPUs = parseCPUList(cpuList);
+    }
+    return nodeCPUs;
+#else
+    (void)node;
+    return {};
+#endif
+}
+
+bool bindMemoryToNode(void* addr, size_t size, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    constexpr size_t NODE_MASK_BITS = 8 * sizeof(unsigned long);
+    if (node < 0 || static_cast<size_t>(node) >= NODE_MASK_BITS) {
+        return false;
+    }
+
+    const unsigned long nodeMask = 1UL << node;
+    return !syscall(SYS_mbind, addr, size, MPOL_PREFERRED_MODE, &nodeMask, NODE_MASK_BITS + 1, 0);
+#else
+    (void)addr;
+    (void)size;
+    (void)node;
+    return false;
+#endif
+}
+
+}  // namespace numa
+
+ScopedNumaAffinity::ScopedNumaAffinity(int node) {
+#if defined(__linux__)
+    if (node == numa::NO_NUMA_NODE) {
+        return;
+    }
+
+    const auto nodeCPUs = numa::getNodeCPUs(node);
+    if (nodeCPUs.empty()) {
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "NUMA node %d is not available, the thread is not pinned", node);
+        return;
+    }
+
+    cpu_set_t previousSet;
+    CPU_ZERO(&previousSet);
+    if (sched_getaffinity(0, sizeof(previousSet), &previousSet)) {
+        return;
+    }
+    for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &previousSet)) {
+            mPreviousCPUs.push_back(cpu);
+        }
+    }
+
+    // only the CPUs the thread may already run on, an empty intersection leaves the affinity untouched
+    cpu_set_t nodeSet;
+    CPU_ZERO(&nodeSet);
+    bool anyCPU = false;
+    for (auto cpu : nodeCPUs) {
+        if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &previousSet)) {
+            CPU_SET(cpu, &nodeSet);
+            anyCPU = true;
+        }
+    }
+    mPinned = anyCPU && !sched_setaffinity(0, sizeof(nodeSet), &nodeSet);
+    if (!mPinned) {
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "Failed to pin the thread to NUMA node %d", node);
+    }
+#else
+    (void)node;
+#endif
+}
+
+ScopedNumaAffinity::~ScopedNumaAffinity() {
+#if defined(__linux__)
+    if (!mPinned) {
+        return;
+    }
+
+    cpu_set_t previousSet;
+    CPU_ZERO(&previousSet);
+    for (auto cpu : mPreviousCPUs) {
+        CPU_SET(cpu, &previousSet);
+    }
+    sched_setaffinity(0, sizeof(previousSet), &previousSet);
+#endif
+}
+
+bool ScopedNumaAffinity::isPinned() const {
+    return mPinned;
+}
+
+}  // namespace elf
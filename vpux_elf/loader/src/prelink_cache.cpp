@@ -0,0 +1,177 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <vpux_elf/utils/log.hpp>
+#include <vpux_headers/prelink_cache.hpp>
+
+namespace elf {
+
+namespace {
+
+// bump when the layout of the entries changes
+constexpr std::array<char, 8> ENTRY_MAGIC = {'N', 'P', 'U', 'P', 'L', 'K', '0', '2'};
+
+struct EntryHeader {
+    std::array<char, 8> magic;
+    utils::Sha256Digest entryKey;
+    uint64_t stateChecksum;
+    uint64_t stateSize;
+};
+
+// only detects corruption of the entries, the loader validates the imported state against the blob anyway
+// the state is checksummed on every warm load, so a word-wise hash is used instead of the SHA-256 of the key
+uint64_t getStateChecksum(const std::vector<uint8_t>& state) {
+    constexpr uint64_t prime = 0x9e3779b97f4a7c15ull;
+    uint64_t checksum = state.size() * prime;
+    size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= state.size(); offset += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, state.data() + offset, sizeof(word));
+        checksum = ((checksum ^ word) * prime) ^ (checksum >> 29);
+    }
+    for (; offset < state.size(); ++offset) {
+        checksum = ((checksum ^ state[offset]) * prime) ^ (checksum >> 29);
+    }
+    return checksum;
+}
+
+std::string toHex(const utils::Sha256Digest& digest) {
+    static const char* hexDigits = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(digest.size() * 2);
+    for (auto byte : digest) {
+        hex.push_back(hexDigits[byte >> 4]);
+        hex.push_back(hexDigits[byte & 0xf]);
+    }
+    return hex;
+}
+
+uint64_t getProcessId() {
+#if defined(_WIN32)
+    return GetCurrentProcessId();
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+}
+
+// Replaces the destination if it exists, like POSIX rename (std::rename fails on Windows in that case)
+bool replaceFile(const std::string& from, const std::string& to) {
+#if defined(_WIN32)
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+}  // namespace
+
+PrelinkCache::PrelinkCache(std::string directory, std::string context)
+        : mDirectory(std::move(directory)), mContext(std::move(context)) {
+}
+
+const std::string& PrelinkCache::getDirectory() const {
+    return mDirectory;
+}
+
+const std::string& PrelinkCache::getContext() const {
+    return mContext;
+}
+
+utils::Sha256Digest PrelinkCache::getEntryKey(const utils::Sha256Digest& key) const {
+    utils::Sha256 hasher;
+    hasher.update(key.data(), key.size());
+    hasher.update(reinterpret_cast<const uint8_t*>(mContext.data()), mContext.size());
+    return hasher.finalize();
+}
+
+std::string PrelinkCache::getEntryPath(const utils::Sha256Digest& entryKey) const {
+    return mDirectory + "/" + toHex(entryKey) + ".prelink";
+}
+
+std::vector<uint8_t> PrelinkCache::read(const utils::Sha256Digest& key) const {
+    const auto entryKey = getEntryKey(key);
+    const auto entryPath = getEntryPath(entryKey);
+
+    std::ifstream stream(entryPath, std::ios::binary);
+    if (!stream) {
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "No prelink cache entry %s", entryPath.c_str());
+        return {};
+    }
+
+    EntryHeader header{};
+    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!stream || header.magic != ENTRY_MAGIC || header.entryKey != entryKey) {
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "Ignoring invalid prelink cache entry %s", entryPath.c_str());
+        return {};
+    }
+
+    // the size is checked against the file before allocating, a corrupted one must not turn into a huge allocation
+    const auto stateOffset = stream.tellg();
+    stream.seekg(0, std::ios::end);
+    const auto fileSize = stream.tellg();
+    stream.seekg(stateOffset);
+    if (!stream || fileSize < stateOffset ||
+        header.stateSize != static_cast<uint64_t>(fileSize - stateOffset)) {
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "Ignoring truncated or corrupted prelink cache entry %s", entryPath.c_str());
+        return {};
+    }
+
+    std::vector<uint8_t> state(static_cast<size_t>(header.stateSize));
+    stream.read(reinterpret_cast<char*>(state.data()), state.size());
+    if (!stream || stream.peek() != std::ifstream::traits_type::eof() ||
+        getStateChecksum(state) != header.stateChecksum) {
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "Ignoring truncated or corrupted prelink cache entry %s", entryPath.c_str());
+        return {};
+    }
+
+    VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "Read prelink cache entry %s", entryPath.c_str());
+    return state;
+}
+
+void PrelinkCache::write(const utils::Sha256Digest& key, const std::vector<uint8_t>& state) const {
+    EntryHeader header{};
+    header.magic = ENTRY_MAGIC;
+    header.entryKey = getEntryKey(key);
+    header.stateChecksum = getStateChecksum(state);
+    header.stateSize = state.size();
+
+    // write to a temporary file first, so that concurrent readers never see a partial entry
+    // thread ids are only unique inside a process, so concurrent writers are told apart by both
+    const auto entryPath = getEntryPath(header.entryKey);
+    const auto tempPath = entryPath + "." + std::to_string(getProcessId()) + "." +
+                          std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(state.data()), state.size());
+        if (!stream) {
+            VPUX_ELF_LOG(LogLevel::LOG_WARN, "Failed to write prelink cache entry %s", tempPath.c_str());
+            std::remove(tempPath.c_str());
+            return;
+        }
+    }
+
+    if (!replaceFile(tempPath, entryPath)) {
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "Failed to store prelink cache entry %s", entryPath.c_str());
+        std::remove(tempPath.c_str());
+        return;
+    }
+    VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "Stored prelink cache entry %s", entryPath.c_str());
+}
+
+}  // namespace elf
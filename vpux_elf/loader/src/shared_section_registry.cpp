@@ -0,0 +1,74 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+#include <iterator>
+
+#include <vpux_elf/utils/log.hpp>
+#include <vpux_headers/shared_section_registry.hpp>
+
+namespace elf {
+
+SharedSectionRegistry& SharedSectionRegistry::getInstance() {
+    static SharedSectionRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<ManagedBuffer> SharedSectionRegistry::findLocked(const Key& key) {
+    auto entry = mBuffers.find(key);
+    if (entry == mBuffers.end()) {
+        return nullptr;
+    }
+
+    auto buffer = entry->second.lock();
+    if (!buffer) {
+        // the last user of the buffer released it
+        mBuffers.erase(entry);
+    }
+    return buffer;
+}
+
+std::shared_ptr<ManagedBuffer> SharedSectionRegistry::getOrCreate(
+        const Key& key, const std::function<std::shared_ptr<ManagedBuffer>()>& createBuffer) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (auto buffer = findLocked(key)) {
+            ++mStats.hits;
+            VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "Reusing shared section buffer of size %llu", key.size);
+            return buffer;
+        }
+        ++mStats.misses;
+    }
+
+    auto createdBuffer = createBuffer();
+    if (!createdBuffer || !createdBuffer->getOwnedSize()) {
+        // emplaced buffers live in the blob of their model, they must not outlive it through other models
+        return createdBuffer;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (auto buffer = findLocked(key)) {
+        return buffer;
+    }
+
+    for (auto entry = mBuffers.begin(); entry != mBuffers.end();) {
+        entry = entry->second.expired() ? mBuffers.erase(entry) : std::next(entry);
+    }
+    mBuffers[key] = createdBuffer;
+    return createdBuffer;
+}
+
+SharedSectionRegistry::Stats SharedSectionRegistry::getStats() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto stats = mStats;
+    for (const auto& entry : mBuffers) {
+        if (auto buffer = entry.second.lock()) {
+            ++stats.liveBuffers;
+            stats.liveSize += buffer->getOwnedSize();
+        }
+    }
+    return stats;
+}
+
+}  // namespace elf
@@ -5,22 +5,38 @@
 
 //
 
+#include <algorithm>
+#include <array>
+#include <condition_variable>
 #include <cstring>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <type_traits>
 
 #include <memory>
 #include <vpux_loader/vpux_loader.hpp>
 #include "vpux_elf/types/section_header.hpp"
 #include "vpux_elf/utils/error.hpp"
+#include "vpux_elf/utils/utils.hpp"
 #include "vpux_headers/buffer_specs.hpp"
 #include "vpux_headers/device_buffer.hpp"
 #include "vpux_headers/device_buffer_container.hpp"
 #include "vpux_headers/managed_buffer.hpp"
+#include "vpux_headers/shared_section_registry.hpp"
 
 #ifndef VPUX_ELF_LOG_UNIT_NAME
 #define VPUX_ELF_LOG_UNIT_NAME "VpuxLoader"
 #endif
 #include <vpux_elf/reader.hpp>
 
+#if defined(__GNUC__) || defined(__clang__)
+#define VPUX_ELF_PREFETCH_FOR_WRITE(addr) __builtin_prefetch((addr), 1)
+#else
+#define VPUX_ELF_PREFETCH_FOR_WRITE(addr)
+#endif
+
 namespace elf {
 
 namespace {
@@ -407,6 +423,205 @@ const auto VPU_HIGH_27_BIT_OR_Relocation = [](void* targetAddr, const elf::Symbo
     *addr |= (static_cast<uint64_t>(patchAddr) << 37);
 };
 
+// Visit the relocations of a SHT_RELA or VPU_SHT_RELA_PACKED section as runs of relocations sharing type and symbol
+// SHT_RELA entries are visited as runs of a single relocation, so both encodings go through the same application loop
+template <typename RunCallback>
+void forEachRelocationRun(Elf_Word sectionType, const void* data, size_t numEntries, RunCallback&& callback) {
+    if (sectionType == VPU_SHT_RELA_PACKED) {
+        auto runs = reinterpret_cast<const VPU_PackedRelocationAEntry*>(data);
+        for (size_t runIdx = 0; runIdx < numEntries; ++runIdx) {
+            VPUX_ELF_THROW_WHEN(runs[runIdx].r_count == 0, RelocError, "Empty packed relocation run");
+            callback(runs[runIdx]);
+        }
+    } else {
+        auto relocations = reinterpret_cast<const RelocationAEntry*>(data);
+        for (size_t relocIdx = 0; relocIdx < numEntries; ++relocIdx) {
+            const auto& relocation = relocations[relocIdx];
+            const VPU_PackedRelocationAEntry run{relocation.r_offset, relocation.r_info, relocation.r_addend, 0, 1, 0};
+            callback(run);
+        }
+    }
+}
+
+template <typename RunCallback>
+void forEachRelocationRun(const Reader<ELF_Bitness::Elf64>::Section& relocSection, RunCallback&& callback) {
+    forEachRelocationRun(relocSection.getHeader()->sh_type, relocSection.getData<void>(),
+                         relocSection.getEntriesNum(), std::forward<RunCallback>(callback));
+}
+
+using PatchRanges = std::vector<std::pair<uint64_t /*begin*/, uint64_t /*end*/>>;
+
+// Append the byte ranges patched by a relocation section. Returns false if the patch size of a relocation is unknown
+bool collectPatchRanges(Elf_Word sectionType, const void* data, size_t numEntries, PatchRanges& ranges) {
+    bool isKnown = true;
+    forEachRelocationRun(sectionType, data, numEntries, [&](const VPU_PackedRelocationAEntry& run) {
+        const auto patchSize = utils::getRelocationPatchSize(elf64RType(run.r_info));
+        isKnown = isKnown && patchSize;
+        for (Elf_Word relocIdx = 0; relocIdx < run.r_count; ++relocIdx) {
+            const auto offset = run.r_offset + static_cast<uint64_t>(relocIdx) * run.r_stride;
+            ranges.emplace_back(offset, offset + patchSize);
+        }
+    });
+    return isKnown;
+}
+
+// True if any two of the ranges share at least a byte
+bool hasOverlaps(PatchRanges ranges) {
+    std::sort(ranges.begin(), ranges.end());
+    for (size_t rangeIdx = 1; rangeIdx < ranges.size(); ++rangeIdx) {
+        if (ranges[rangeIdx].first < ranges[rangeIdx - 1].second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Relocations whose patched value changes exactly by the address delta of the symbol's section when it is moved
+bool isLinearRelocation(Elf_Word relocationType) {
+    switch (relocationType) {
+    case R_VPU_64:
+    case R_VPU_32:
+    case R_VPU_32_SUM:
+    case R_VPU_16_SUM:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void addAddressDelta(uint8_t* addr, size_t patchSize, uint64_t delta) {
+    switch (patchSize) {
+    case sizeof(uint64_t):
+        *reinterpret_cast<uint64_t*>(addr) += delta;
+        break;
+    case sizeof(uint32_t):
+        *reinterpret_cast<uint32_t*>(addr) += static_cast<uint32_t>(delta);
+        break;
+    case sizeof(uint16_t):
+        *reinterpret_cast<uint16_t*>(addr) += static_cast<uint16_t>(delta);
+        break;
+    default:
+        VPUX_ELF_THROW(RelocError, "Unexpected patch size of linear relocation");
+    }
+}
+
+// The last patch of the run must be inside the target section
+bool isRelocationRunInBounds(const VPU_PackedRelocationAEntry& run, size_t patchSize, size_t sectionSize) {
+    const uint64_t lastPatchSize = std::max<size_t>(patchSize, 1);
+    return lastPatchSize <= sectionSize && run.r_offset <= sectionSize - lastPatchSize &&
+           static_cast<uint64_t>(run.r_count - 1) * run.r_stride <= sectionSize - lastPatchSize - run.r_offset;
+}
+
+const size_t RELOCATION_WINDOW_SIZE = 4 * 1024;
+const size_t RELOCATION_WINDOW_COALESCE_GAP = 64;
+const size_t RELOCATION_PREFETCH_DISTANCE = 256;
+
+// Staging window used for relocation sections flagged with VPU_SHF_RELA_SORTED
+// Patches are applied on a cached copy of the target section and neighbouring patches (closer than
+// RELOCATION_WINDOW_COALESCE_GAP) are coalesced into a single write back to the target section. This replaces many
+// scattered accesses to the (possibly write-combined) device mapping with few sequential copies
+class RelocationWindow {
+public:
+    RelocationWindow(uint8_t* target, size_t targetSize): mTarget(target), mTargetSize(targetSize) {
+    }
+
+    // the patch [offset, offset + size) must be inside the target section
+    uint8_t* acquire(size_t offset, size_t size) {
+        if (mStart == mEnd || offset < mStart || offset > mEnd + RELOCATION_WINDOW_COALESCE_GAP ||
+            offset + size - mStart > RELOCATION_WINDOW_SIZE) {
+            flush();
+            // keep the alignment of the patches inside the staging buffer the same as inside the target section
+            mStart = mEnd = offset & ~(alignof(uint64_t) - 1);
+        }
+
+        if (offset + size > mEnd) {
+            memcpy(mStaging.data() + (mEnd - mStart), mTarget + mEnd, offset + size - mEnd);
+            mEnd = offset + size;
+            VPUX_ELF_PREFETCH_FOR_WRITE(mTarget + std::min(mEnd + RELOCATION_PREFETCH_DISTANCE, mTargetSize - 1));
+        }
+
+        return mStaging.data() + (offset - mStart);
+    }
+
+    void flush() {
+        if (mEnd > mStart) {
+            memcpy(mTarget + mStart, mStaging.data(), mEnd - mStart);
+        }
+        mStart = mEnd = 0;
+    }
+
+private:
+    uint8_t* mTarget;
+    size_t mTargetSize;
+    size_t mStart = 0;
+    size_t mEnd = 0;
+    alignas(64) std::array<uint8_t, RELOCATION_WINDOW_SIZE> mStaging;
+};
+
+// bump when the layout of the prelink state changes
+constexpr uint32_t PRELINK_STATE_VERSION = 1;
+// serialized size of a RelocationRun: offset, addend, addendStride and 5 words
+constexpr size_t PRELINK_RUN_SIZE = 3 * sizeof(uint64_t) + 5 * sizeof(Elf_Word);
+
+class PrelinkStateWriter {
+public:
+    template <typename T>
+    void write(T value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be serialized");
+        const auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        mState.insert(mState.end(), bytes, bytes + sizeof(value));
+    }
+
+    std::vector<uint8_t>& getState() {
+        return mState;
+    }
+
+private:
+    std::vector<uint8_t> mState;
+};
+
+// Reads values until the state is exhausted, from then on only zeros are returned and isValid is false
+class PrelinkStateReader {
+public:
+    explicit PrelinkStateReader(const std::vector<uint8_t>& state): mState(state) {
+    }
+
+    template <typename T>
+    T read() {
+        T value{};
+        if (mState.size() - mOffset < sizeof(value)) {
+            mValid = false;
+            return value;
+        }
+        memcpy(&value, mState.data() + mOffset, sizeof(value));
+        mOffset += sizeof(value);
+        return value;
+    }
+
+    // Reads an element count, checked against the remaining bytes so that it can be used to reserve memory
+    size_t readCount(size_t serializedElementSize) {
+        const auto count = read<uint64_t>();
+        if (count > (mState.size() - mOffset) / serializedElementSize) {
+            mValid = false;
+            return 0;
+        }
+        return static_cast<size_t>(count);
+    }
+
+    bool isValid() const {
+        return mValid;
+    }
+
+    bool isExhausted() const {
+        return mOffset == mState.size();
+    }
+
+private:
+    const std::vector<uint8_t>& mState;
+    size_t mOffset = 0;
+    bool mValid = true;
+};
+
 }  // namespace
 
 const std::map<Elf_Word, VPUXLoader::Action> VPUXLoader::actionMap = {
@@ -415,6 +630,7 @@ const std::map<Elf_Word, VPUXLoader::Action> VPUXLoader::actionMap = {
         {SHT_SYMTAB, Action::RegisterUserIO},
         {SHT_STRTAB, Action::None},
         {SHT_RELA, Action::Relocate},
+        {VPU_SHT_RELA_PACKED, Action::Relocate},
         {SHT_HASH, Action::Error},
         {SHT_DYNAMIC, Action::Error},
         {SHT_NOTE, Action::None},
@@ -460,8 +676,10 @@ const std::map<VPUXLoader::RelocationType, VPUXLoader::RelocationFunc> VPUXLoade
         {R_VPU_HIGH_27_BIT_OR, VPU_HIGH_27_BIT_OR_Relocation},
 };
 
-VPUXLoader::VPUXLoader(AccessManager* accessor, BufferManager* bufferManager)
-        : m_inferBufferContainer(bufferManager),
+VPUXLoader::VPUXLoader(AccessManager* accessor, BufferManager* bufferManager, const PrelinkCache* prelinkCache,
+                       const utils::Sha256Digest& blobDigest)
+        : m_accessor(accessor),
+          m_inferBufferContainer(bufferManager),
           m_backupBufferContainer(bufferManager),
           m_relocationSectionIndexes(std::make_shared<std::vector<std::size_t>>()),
           m_jitRelocations(std::make_shared<std::vector<std::size_t>>()),
@@ -470,12 +688,16 @@ VPUXLoader::VPUXLoader(AccessManager* accessor, BufferManager* bufferManager)
           m_profOutputsDescriptors(std::make_shared<std::vector<DeviceBuffer>>()),
           m_loaded(false), m_inferencesMayBeRunInParallel(true) {
     VPUX_ELF_THROW_UNLESS(bufferManager, ArgsError, "Invalid BufferManager pointer");
+    VPUX_ELF_THROW_WHEN(prelinkCache && blobDigest == utils::Sha256Digest{}, ArgsError,
+                        "The prelink cache requires the digest of the blob");
     m_bufferManager = bufferManager;
     m_reader = std::make_shared<Reader<ELF_Bitness::Elf64>>(m_bufferManager, accessor);
     m_sectionMap = std::make_shared<std::map<elf::Elf_Word /*section type*/, std::vector<size_t>>>();
 
     VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Initializing... Register sections");
     auto numSections = m_reader->getSectionsNum();
+    std::vector<std::size_t> relocationSectionIndexes;
+    std::vector<std::size_t> userIOSectionIndexes;
     for (size_t sectionCtr = 0; sectionCtr < numSections; ++sectionCtr) {
         auto section = m_reader->getSection(sectionCtr);
         auto sectionType = section.getHeader()->sh_type;
@@ -485,8 +707,39 @@ VPUXLoader::VPUXLoader(AccessManager* accessor, BufferManager* bufferManager)
 
         // Early fetch of IO buffer specs
         const auto action = actionMap.find(sectionType);
+        if (action == actionMap.end()) {
+            continue;
+        }
+
         if (action->second == Action::RegisterUserIO) {
-            earlyFetchIO(section);
+            userIOSectionIndexes.push_back(sectionCtr);
+        } else if (action->second == Action::Relocate) {
+            relocationSectionIndexes.push_back(sectionCtr);
+        }
+    }
+
+    const auto prelinkKey = prelinkCache ? getPrelinkKey(blobDigest) : utils::Sha256Digest{};
+    if (!prelinkCache || !importPrelinkState(prelinkCache->read(prelinkKey), relocationSectionIndexes)) {
+        for (auto userIOSectionIdx : userIOSectionIndexes) {
+            earlyFetchIO(m_reader->getSection(userIOSectionIdx));
+        }
+        compileRelocationPlan(relocationSectionIndexes);
+
+        // the state replaces reading and decoding the relocation sections, an entry which is not smaller than them
+        // (relocations that don't coalesce into runs) would make later constructions slower, so it is not stored
+        if (prelinkCache) {
+            size_t relocationBytes = 0;
+            size_t runsBytes = 0;
+            for (auto relocationSectionIdx : relocationSectionIndexes) {
+                relocationBytes += m_reader->getSection(relocationSectionIdx).getHeader()->sh_size;
+                runsBytes += m_relocationPlan->sections.at(relocationSectionIdx).runs.size() * PRELINK_RUN_SIZE;
+            }
+            if (runsBytes < relocationBytes) {
+                prelinkCache->write(prelinkKey, exportPrelinkState());
+            } else {
+                VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "Relocation runs of %zu bytes not smaller than the relocations",
+                             runsBytes);
+            }
         }
     }
 
@@ -496,12 +749,21 @@ VPUXLoader::VPUXLoader(AccessManager* accessor, BufferManager* bufferManager)
     }
 };
 
-VPUXLoader::VPUXLoader(const VPUXLoader& other)
+VPUXLoader::VPUXLoader(std::shared_ptr<AccessManager> accessor, BufferManager* bufferManager,
+                       const PrelinkCache* prelinkCache, const utils::Sha256Digest& blobDigest)
+        : VPUXLoader(accessor.get(), bufferManager, prelinkCache, blobDigest) {
+    m_ownedAccessor = std::move(accessor);
+}
+
+VPUXLoader::VPUXLoader(CopyBudgetChecked, const VPUXLoader& other, const std::vector<SymbolEntry>& runtimeSymTabs)
         : m_bufferManager(other.m_bufferManager),
+          m_accessor(other.m_accessor),
+          m_ownedAccessor(other.m_ownedAccessor),
           m_reader(other.m_reader),
           m_inferBufferContainer(other.m_inferBufferContainer),
           m_backupBufferContainer(other.m_backupBufferContainer),
-          m_runtimeSymTabs(other.m_runtimeSymTabs),
+          m_runtimeSymTabs(runtimeSymTabs),
+          m_relocationPlan(other.m_relocationPlan),
           m_relocationSectionIndexes(other.m_relocationSectionIndexes),
           m_jitRelocations(other.m_jitRelocations),
           m_userInputsDescriptors(other.m_userInputsDescriptors),
@@ -513,32 +775,46 @@ VPUXLoader::VPUXLoader(const VPUXLoader& other)
           m_loaded(other.m_loaded),
           m_symbolSectionTypes(other.m_symbolSectionTypes),
           m_inferencesMayBeRunInParallel(other.m_inferencesMayBeRunInParallel),
-          m_sharedScratchBuffers(other.m_sharedScratchBuffers) {
+          m_arenaAllocations(other.m_arenaAllocations),
+          m_segmentAllocations(other.m_segmentAllocations),
+          m_backupFreeReload(other.m_backupFreeReload),
+          m_profilingElision(other.m_profilingElision),
+          m_profilingDummyAddress(other.m_profilingDummyAddress),
+          m_pipelinedLoad(other.m_pipelinedLoad),
+          m_maxSectionsInFlight(other.m_maxSectionsInFlight),
+          m_sharedSectionDeduplication(other.m_sharedSectionDeduplication),
+          m_streamingUpload(other.m_streamingUpload),
+          m_streamingChunkSize(other.m_streamingChunkSize),
+          m_numaNode(other.m_numaNode),
+          m_memoryBudget(other.m_memoryBudget),
+          m_sharedScratchBuffers(other.m_sharedScratchBuffers),
+          m_placementHints(other.m_placementHints),
+          m_rebaseSites(other.m_rebaseSites) {
+}
+
+VPUXLoader::VPUXLoader(const VPUXLoader& other)
+        : VPUXLoader(other.checkCopyMemoryBudget(), other, other.m_runtimeSymTabs) {
+    ScopedNumaAffinity numaAffinity(m_numaNode);
+    auto workingSetLock =
+            ElfBufferBatchLockGuard(getWorkingSet(getReloadedSections(), *m_relocationSectionIndexes));
     reloadNewBuffers();
+    resolveSymbolTables(*m_relocationSectionIndexes);
     applyRelocations(*m_relocationSectionIndexes);
+    updatePeakMemoryUsage();
 }
 
 // override the symbol table for the newly created loader
 VPUXLoader::VPUXLoader(const VPUXLoader& other, const std::vector<SymbolEntry>& runtimeSymTabs)
-        : m_bufferManager(other.m_bufferManager),
-          m_reader(other.m_reader),
-          m_inferBufferContainer(other.m_inferBufferContainer),
-          m_backupBufferContainer(other.m_backupBufferContainer),
-          m_runtimeSymTabs(runtimeSymTabs),
-          m_relocationSectionIndexes(other.m_relocationSectionIndexes),
-          m_jitRelocations(other.m_jitRelocations),
-          m_userInputsDescriptors(other.m_userInputsDescriptors),
-          m_userOutputsDescriptors(other.m_userOutputsDescriptors),
-          m_profOutputsDescriptors(other.m_profOutputsDescriptors),
-          m_sectionMap(other.m_sectionMap),
-          m_symTabOverrideMode(other.m_symTabOverrideMode),
-          m_explicitAllocations(other.m_explicitAllocations),
-          m_loaded(other.m_loaded),
-          m_symbolSectionTypes(other.m_symbolSectionTypes),
-          m_inferencesMayBeRunInParallel(other.m_inferencesMayBeRunInParallel),
-          m_sharedScratchBuffers(other.m_sharedScratchBuffers) {
+        : VPUXLoader(other.checkCopyMemoryBudget(), other, runtimeSymTabs) {
+    ScopedNumaAffinity numaAffinity(m_numaNode);
+    checkRuntimeSymTabs();
+
+    auto workingSetLock =
+            ElfBufferBatchLockGuard(getWorkingSet(getReloadedSections(), *m_relocationSectionIndexes));
     reloadNewBuffers();
+    resolveSymbolTables(*m_relocationSectionIndexes);
     applyRelocations(*m_relocationSectionIndexes);
+    updatePeakMemoryUsage();
 }
 
 VPUXLoader& VPUXLoader::operator=(const VPUXLoader& other) {
@@ -546,11 +822,16 @@ VPUXLoader& VPUXLoader::operator=(const VPUXLoader& other) {
         return *this;
     }
 
+    other.checkCopyMemoryBudget();
+
     m_bufferManager = other.m_bufferManager;
+    m_accessor = other.m_accessor;
+    m_ownedAccessor = other.m_ownedAccessor;
     m_reader = other.m_reader;
     m_inferBufferContainer = other.m_inferBufferContainer;
     m_backupBufferContainer = other.m_backupBufferContainer;
     m_runtimeSymTabs = other.m_runtimeSymTabs;
+    m_relocationPlan = other.m_relocationPlan;
     m_relocationSectionIndexes = other.m_relocationSectionIndexes;
     m_jitRelocations = other.m_jitRelocations;
     m_userInputsDescriptors = other.m_userInputsDescriptors;
@@ -562,10 +843,29 @@ VPUXLoader& VPUXLoader::operator=(const VPUXLoader& other) {
     m_sectionMap = other.m_sectionMap;
     m_loaded = other.m_loaded;
     m_inferencesMayBeRunInParallel = other.m_inferencesMayBeRunInParallel;
+    m_arenaAllocations = other.m_arenaAllocations;
+    m_segmentAllocations = other.m_segmentAllocations;
+    m_backupFreeReload = other.m_backupFreeReload;
+    m_profilingElision = other.m_profilingElision;
+    m_profilingDummyAddress = other.m_profilingDummyAddress;
+    m_pipelinedLoad = other.m_pipelinedLoad;
+    m_maxSectionsInFlight = other.m_maxSectionsInFlight;
+    m_sharedSectionDeduplication = other.m_sharedSectionDeduplication;
+    m_streamingUpload = other.m_streamingUpload;
+    m_streamingChunkSize = other.m_streamingChunkSize;
+    m_numaNode = other.m_numaNode;
+    m_memoryBudget = other.m_memoryBudget;
     m_sharedScratchBuffers = other.m_sharedScratchBuffers;
+    m_placementHints = other.m_placementHints;
+    m_rebaseSites = other.m_rebaseSites;
+    m_jitRelocationsApplied = false;
 
+    auto workingSetLock =
+            ElfBufferBatchLockGuard(getWorkingSet(getReloadedSections(), *m_relocationSectionIndexes));
     reloadNewBuffers();
+    resolveSymbolTables(*m_relocationSectionIndexes);
     applyRelocations(*m_relocationSectionIndexes);
+    updatePeakMemoryUsage();
 
     return *this;
 }
@@ -604,15 +904,22 @@ void VPUXLoader::load(const std::vector<SymbolEntry>& runtimeSymTabs, bool symTa
     VPUX_ELF_THROW_WHEN(m_loaded, SequenceError, "Sections were previously loaded.");
 
     m_runtimeSymTabs = runtimeSymTabs;
+    checkRuntimeSymTabs();
     m_symTabOverrideMode = symTabOverrideMode;
     m_explicitAllocations = symTabOverrideMode;
     m_symbolSectionTypes = symbolSectionTypes;
 
+    // fail before allocating anything
+    m_memoryBudget.check(estimateLoadMemoryUsage(symTabOverrideMode), "load");
+
+    ScopedNumaAffinity numaAffinity(m_numaNode);
+
     VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Starting LOAD process");
     auto numSections = m_reader->getSectionsNum();
 
     m_relocationSectionIndexes->reserve(numSections);
     m_jitRelocations->reserve(2);
+    computePlacementHints();
 
     VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "Got elf with %zu sections", numSections);
     for (size_t sectionCtr = 0; sectionCtr < numSections; ++sectionCtr) {
@@ -645,7 +952,7 @@ void VPUXLoader::load(const std::vector<SymbolEntry>& runtimeSymTabs, bool symTa
         switch (action) {
         case Action::AllocateAndLoad: {
             bool isAllocateable = sectionFlags & SHF_ALLOC;
-            if (m_explicitAllocations && !isAllocateable) {
+            if ((m_explicitAllocations && !isAllocateable) || hasElidedProfOutputFlag(sectionCtr)) {
                 break;
             }
 
@@ -689,8 +996,17 @@ void VPUXLoader::load(const std::vector<SymbolEntry>& runtimeSymTabs, bool symTa
             }
 
             auto& inferBufferInfo = m_inferBufferContainer.safeInitBufferInfoAtIndex(sectionCtr);
+            inferBufferInfo.mBufferDetails.mHasData = false;
+            inferBufferInfo.mBufferDetails.mIsShared = false;
+            inferBufferInfo.mBufferDetails.mIsProcessed = true;
+
+            if ((m_arenaAllocations || m_segmentAllocations) && !(sectionFlags & elf::SHARABLE_BUFFER_ENABLED)) {
+                // sub-allocated from a segment by allocateSegmentBuffers or from an arena by allocateArenaBuffers
+                break;
+            }
+
             inferBufferInfo.mBuffer = m_inferBufferContainer.buildAllocatedDeviceBuffer(
-                    BufferSpecs(sectionAlignment, sectionSize, sectionFlags));
+                    BufferSpecs(sectionAlignment, sectionSize, sectionFlags, m_placementHints[sectionCtr]));
 
             if (inferBufferInfo.mBuffer->getBuffer().cpu_addr() == nullptr) {
                 // driver did share scratch and returned empty allocation
@@ -698,17 +1014,21 @@ void VPUXLoader::load(const std::vector<SymbolEntry>& runtimeSymTabs, bool symTa
                 m_sharedScratchBuffers.push_back(sectionCtr);
             }
 
-            inferBufferInfo.mBufferDetails.mHasData = false;
-            inferBufferInfo.mBufferDetails.mIsShared = false;
-            inferBufferInfo.mBufferDetails.mIsProcessed = true;
-
             VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tFor section %s Allocated %p of size %llu", section.getName(),
                          inferBufferInfo.mBuffer->getBuffer().cpu_addr(), sectionSize);
             break;
         }
 
         case Action::Relocate: {
-            if (sectionFlags & VPU_SHF_JIT) {
+            if (hasElidedProfOutputFlag(sectionHeader->sh_info)) {
+                VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "Skipping Relocation %zu of elided profiling section", sectionCtr);
+            } else if ((sectionFlags & VPU_SHF_JIT) && hasElidedProfOutputFlag(sectionCtr)) {
+                // profiling pointers are patched once against the dummy profiling address, like regular relocations
+                section.getData<void>();
+
+                VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "Registering profiling JIT Relocation %zu as Relocation", sectionCtr);
+                m_relocationSectionIndexes->push_back(static_cast<int>(sectionCtr));
+            } else if (sectionFlags & VPU_SHF_JIT) {
                 // Trigger read of section data so that after load completes the AccessManager object can
                 // be safely deleted
                 section.getData<void>();
@@ -751,14 +1071,16 @@ void VPUXLoader::load(const std::vector<SymbolEntry>& runtimeSymTabs, bool symTa
     // Load actual buffers for the first time
     loadBuffers();
 
-    if (m_sharedScratchBuffers.empty()) {
+    if (m_sharedScratchBuffers.empty() && !m_pipelinedLoad) {
         // execute relocations only if sharing did not happen
         // otherwise we have empty allocations and cannot trigger relocations
         // unless shared allocations become available (after updateSharedScratchBuffers)
+        resolveSymbolTables(*m_relocationSectionIndexes);
         applyRelocations(*m_relocationSectionIndexes);
     }
 
     VPUX_ELF_LOG(LogLevel::LOG_INFO, "Allocated %zu sections", m_inferBufferContainer.getBufferInfoCount());
+    updatePeakMemoryUsage();
 
     // sections were loaded. other calls to this method will throw an error
     m_loaded = true;
@@ -766,6 +1088,296 @@ void VPUXLoader::load(const std::vector<SymbolEntry>& runtimeSymTabs, bool symTa
     return;
 }
 
+void VPUXLoader::compileRelocationPlan(const std::vector<std::size_t>& relocationSectionIndexes) {
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Compile relocation plan");
+    auto plan = std::make_shared<RelocationPlan>();
+    const auto numSections = m_reader->getSectionsNum();
+
+    for (const auto& relocationSectionIdx : relocationSectionIndexes) {
+        const auto& relocSection = m_reader->getSection(relocationSectionIdx);
+        const auto relocSecHdr = relocSection.getHeader();
+        const auto relocSecFlags = relocSecHdr->sh_flags;
+        const bool isJit = relocSecFlags & VPU_SHF_JIT;
+
+        const auto expectedEntrySize = relocSecHdr->sh_type == VPU_SHT_RELA_PACKED
+                                               ? sizeof(VPU_PackedRelocationAEntry)
+                                               : sizeof(RelocationAEntry);
+        VPUX_ELF_THROW_UNLESS(relocSecHdr->sh_entsize == expectedEntrySize, SectionError,
+                              "Unexpected entry size of relocation section");
+
+        VPUX_ELF_THROW_UNLESS(relocSecFlags & SHF_INFO_LINK, RelocError, "Rela section with no target section");
+        const auto targetSectionIdx = relocSecHdr->sh_info;
+        VPUX_ELF_THROW_WHEN(targetSectionIdx == 0 || targetSectionIdx >= numSections, RelocError,
+                            "invalid target section from rela section");
+        const auto targetSectionSize = m_reader->getSection(targetSectionIdx).getHeader()->sh_size;
+
+        // sh_link must point to the associated symbol table or, for regular relocations only, to the "built-in"
+        // runtime symtab
+        const auto symTabIdx = relocSecHdr->sh_link;
+        size_t symTabEntries = 0;
+        if (symTabIdx == VPU_RT_SYMTAB) {
+            VPUX_ELF_THROW_WHEN(isJit, RelocError, "JitReloc pointing to runtime symtab idx");
+        } else {
+            VPUX_ELF_THROW_UNLESS(symTabIdx < numSections, RangeError, "sh_link exceeds the number of entries.");
+            const auto& symTabSection = m_reader->getSection(symTabIdx);
+            VPUX_ELF_THROW_UNLESS(checkSectionType(symTabSection.getHeader(), elf::SHT_SYMTAB), RelocError,
+                                  "Reloc section pointing to non-symtab");
+            symTabEntries = symTabSection.getEntriesNum();
+        }
+
+        VPUX_ELF_THROW_WHEN(isJit && !(relocSecFlags & (VPU_SHF_USERINPUT | VPU_SHF_USEROUTPUT | VPU_SHF_PROFOUTPUT)),
+                            RelocError, "Jit reloc section pointing neither to userInput nor userOutput");
+
+        auto& sectionPlan = plan->sections[relocationSectionIdx];
+        sectionPlan.symTabIdx = symTabIdx;
+        sectionPlan.targetSectionIdx = targetSectionIdx;
+        sectionPlan.flags = relocSecFlags;
+        sectionPlan.symbolsCount = 0;
+
+        const bool isSorted = relocSecFlags & VPU_SHF_RELA_SORTED;
+        forEachRelocationRun(relocSection, [&](const VPU_PackedRelocationAEntry& run) {
+            const auto relSymIdx = elf64RSym(run.r_info);
+            const auto relType = elf64RType(run.r_info);
+
+            auto reloc = relocationMap.find(static_cast<RelocationType>(relType));
+            VPUX_ELF_THROW_WHEN(reloc == relocationMap.end() || reloc->second == nullptr, RelocError,
+                                "Invalid relocation type detected");
+
+            const auto patchSize = utils::getRelocationPatchSize(relType);
+            VPUX_ELF_THROW_WHEN(isSorted && !patchSize, RelocError, "Unknown patch size of sorted relocation");
+            VPUX_ELF_THROW_UNLESS(isRelocationRunInBounds(run, patchSize, targetSectionSize), RelocError,
+                                  "RelocOffset outside of the section size");
+
+            VPUX_ELF_THROW_WHEN(symTabIdx != VPU_RT_SYMTAB && relSymIdx >= symTabEntries, RelocError,
+                                "SymTab index out of bounds!");
+            VPUX_ELF_THROW_WHEN(isJit && relSymIdx == 0, RelocError,
+                                "Invalid symbol index. It exceeds the number of relevant device buffers");
+            sectionPlan.symbolsCount = std::max<size_t>(sectionPlan.symbolsCount, relSymIdx + 1);
+
+            // neighbouring relocations are folded into the previous run like writer packing does, so that plain
+            // sections get as few runs (and as small a prelink state) as packed ones
+            if (run.r_count == 1 && !sectionPlan.runs.empty()) {
+                auto& lastRun = sectionPlan.runs.back();
+                const auto lastOffset = lastRun.offset + static_cast<Elf64_Addr>(lastRun.count - 1) * lastRun.stride;
+                const auto lastAddend = static_cast<uint64_t>(lastRun.addend) +
+                                        static_cast<uint64_t>(lastRun.count - 1) *
+                                                static_cast<uint64_t>(lastRun.addendStride);
+                if (lastRun.type == relType && lastRun.symIdx == relSymIdx && run.r_offset > lastOffset &&
+                    run.r_offset - lastOffset <= std::numeric_limits<Elf_Word>::max() &&
+                    lastRun.count < std::numeric_limits<Elf_Word>::max()) {
+                    const auto stride = static_cast<Elf_Word>(run.r_offset - lastOffset);
+                    const auto addendStride = static_cast<Elf_Sxword>(static_cast<uint64_t>(run.r_addend) - lastAddend);
+                    if (lastRun.count == 1) {
+                        lastRun.stride = stride;
+                        lastRun.addendStride = addendStride;
+                    }
+                    if (stride == lastRun.stride && addendStride == lastRun.addendStride) {
+                        ++lastRun.count;
+                        return;
+                    }
+                }
+            }
+
+            sectionPlan.runs.push_back({&reloc->second, run.r_offset, run.r_addend, run.r_addend_stride, relType,
+                                        relSymIdx, run.r_count, run.r_stride, static_cast<Elf_Word>(patchSize)});
+        });
+
+        if (symTabIdx == VPU_RT_SYMTAB) {
+            plan->runtimeSymbolsCount = std::max(plan->runtimeSymbolsCount, sectionPlan.symbolsCount);
+        }
+
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tCompiled relocation section %zu into %zu runs", relocationSectionIdx,
+                     sectionPlan.runs.size());
+    }
+
+    m_relocationPlan = plan;
+}
+
+utils::Sha256Digest VPUXLoader::getPrelinkKey(const utils::Sha256Digest& blobDigest) const {
+    // the contents of the blob are identified by the digest supplied by the caller, the headers already read by the
+    // Reader are added so that a digest passed with the wrong blob can't select a plan for other sections
+    utils::Sha256 hasher;
+    hasher.update(blobDigest.data(), blobDigest.size());
+    hasher.update(reinterpret_cast<const uint8_t*>(m_reader->getHeader()), sizeof(*m_reader->getHeader()));
+    for (size_t sectionCtr = 0; sectionCtr < m_reader->getSectionsNum(); ++sectionCtr) {
+        const auto sectionHeader = m_reader->getSection(sectionCtr).getHeader();
+        hasher.update(reinterpret_cast<const uint8_t*>(sectionHeader), sizeof(*sectionHeader));
+    }
+    return hasher.finalize();
+}
+
+std::vector<uint8_t> VPUXLoader::exportPrelinkState() const {
+    PrelinkStateWriter writer;
+    writer.write(PRELINK_STATE_VERSION);
+
+    for (const auto& userIO : {m_userInputsDescriptors, m_userOutputsDescriptors, m_profOutputsDescriptors}) {
+        writer.write(static_cast<uint64_t>(userIO->size()));
+        for (const auto& descriptor : *userIO) {
+            writer.write(static_cast<uint64_t>(descriptor.size()));
+        }
+    }
+
+    writer.write(static_cast<uint64_t>(m_relocationPlan->runtimeSymbolsCount));
+    writer.write(static_cast<uint64_t>(m_relocationPlan->sections.size()));
+    for (const auto& section : m_relocationPlan->sections) {
+        const auto& sectionPlan = section.second;
+        writer.write(static_cast<uint64_t>(section.first));
+        writer.write(sectionPlan.symTabIdx);
+        writer.write(sectionPlan.targetSectionIdx);
+        writer.write(sectionPlan.flags);
+        writer.write(static_cast<uint64_t>(sectionPlan.symbolsCount));
+        writer.write(static_cast<uint64_t>(sectionPlan.runs.size()));
+        for (const auto& run : sectionPlan.runs) {
+            writer.write(run.offset);
+            writer.write(run.addend);
+            writer.write(run.addendStride);
+            writer.write(run.type);
+            writer.write(run.symIdx);
+            writer.write(run.count);
+            writer.write(run.stride);
+            writer.write(run.patchSize);
+        }
+    }
+    return std::move(writer.getState());
+}
+
+bool VPUXLoader::importPrelinkState(const std::vector<uint8_t>& state,
+                                    const std::vector<std::size_t>& relocationSectionIndexes) {
+    if (state.empty()) {
+        return false;
+    }
+
+    PrelinkStateReader reader(state);
+    if (reader.read<uint32_t>() != PRELINK_STATE_VERSION) {
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "Prelink state of another version, recomputing it");
+        return false;
+    }
+
+    std::array<std::vector<DeviceBuffer>, 3> userIOs;
+    for (auto& userIO : userIOs) {
+        userIO.resize(reader.readCount(sizeof(uint64_t)));
+        for (auto& descriptor : userIO) {
+            descriptor = DeviceBuffer(nullptr, 0, reader.read<uint64_t>());
+        }
+    }
+
+    const auto numSections = m_reader->getSectionsNum();
+    auto plan = std::make_shared<RelocationPlan>();
+    plan->runtimeSymbolsCount = reader.read<uint64_t>();
+    const auto sectionsCount = reader.readCount(sizeof(uint64_t));
+    for (size_t sectionIdx = 0; sectionIdx < sectionsCount && reader.isValid(); ++sectionIdx) {
+        const auto relocationSectionIdx = reader.read<uint64_t>();
+        auto& sectionPlan = plan->sections[relocationSectionIdx];
+        sectionPlan.symTabIdx = reader.read<Elf_Word>();
+        sectionPlan.targetSectionIdx = reader.read<Elf_Word>();
+        sectionPlan.flags = reader.read<Elf_Xword>();
+        sectionPlan.symbolsCount = reader.read<uint64_t>();
+        if (relocationSectionIdx >= numSections || sectionPlan.targetSectionIdx >= numSections) {
+            return false;
+        }
+
+        sectionPlan.runs.resize(reader.readCount(PRELINK_RUN_SIZE));
+        for (auto& run : sectionPlan.runs) {
+            run.offset = reader.read<Elf64_Addr>();
+            run.addend = reader.read<Elf_Sxword>();
+            run.addendStride = reader.read<Elf_Sxword>();
+            run.type = reader.read<Elf_Word>();
+            run.symIdx = reader.read<Elf_Word>();
+            run.count = reader.read<Elf_Word>();
+            run.stride = reader.read<Elf_Word>();
+            run.patchSize = reader.read<Elf_Word>();
+
+            // functions are bound again, the relocation types of the library may have changed
+            auto reloc = relocationMap.find(run.type);
+            if (reloc == relocationMap.end() || reloc->second == nullptr) {
+                return false;
+            }
+            run.relocFunc = &reloc->second;
+        }
+    }
+
+    if (!reader.isValid() || !reader.isExhausted()) {
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "Malformed prelink state, recomputing it");
+        return false;
+    }
+
+    // the state checksum only detects corruption, a forged entry must not turn into out of bounds patches
+    if (!isImportedRelocationPlanValid(*plan, relocationSectionIndexes)) {
+        VPUX_ELF_LOG(LogLevel::LOG_WARN, "Prelink state inconsistent with the blob, recomputing it");
+        return false;
+    }
+
+    *m_userInputsDescriptors = std::move(userIOs[0]);
+    *m_userOutputsDescriptors = std::move(userIOs[1]);
+    *m_profOutputsDescriptors = std::move(userIOs[2]);
+    m_relocationPlan = plan;
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Imported prelink state of %zu relocation sections", plan->sections.size());
+    return true;
+}
+
+bool VPUXLoader::isImportedRelocationPlanValid(const RelocationPlan& plan,
+                                               const std::vector<std::size_t>& relocationSectionIndexes) const {
+    if (plan.sections.size() != relocationSectionIndexes.size()) {
+        return false;
+    }
+
+    const auto numSections = m_reader->getSectionsNum();
+    for (auto relocationSectionIdx : relocationSectionIndexes) {
+        const auto sectionPlan = plan.sections.find(relocationSectionIdx);
+        if (sectionPlan == plan.sections.end()) {
+            return false;
+        }
+
+        // the plan must describe the relocation section as found in the blob
+        const auto relocSecHdr = m_reader->getSection(relocationSectionIdx).getHeader();
+        const auto& sectionRelocPlan = sectionPlan->second;
+        const bool isJit = relocSecHdr->sh_flags & VPU_SHF_JIT;
+        if (sectionRelocPlan.flags != relocSecHdr->sh_flags || sectionRelocPlan.symTabIdx != relocSecHdr->sh_link ||
+            sectionRelocPlan.targetSectionIdx != relocSecHdr->sh_info || sectionRelocPlan.targetSectionIdx == 0 ||
+            sectionRelocPlan.targetSectionIdx >= numSections) {
+            return false;
+        }
+
+        const auto symTabIdx = sectionRelocPlan.symTabIdx;
+        if (symTabIdx == VPU_RT_SYMTAB) {
+            if (isJit || sectionRelocPlan.symbolsCount > plan.runtimeSymbolsCount) {
+                return false;
+            }
+        } else {
+            if (symTabIdx >= numSections) {
+                return false;
+            }
+            const auto symTabHdr = m_reader->getSection(symTabIdx).getHeader();
+            if (!checkSectionType(symTabHdr, elf::SHT_SYMTAB) || !symTabHdr->sh_entsize ||
+                sectionRelocPlan.symbolsCount > symTabHdr->sh_size / symTabHdr->sh_entsize) {
+                return false;
+            }
+        }
+
+        const auto targetSectionSize = m_reader->getSection(sectionRelocPlan.targetSectionIdx).getHeader()->sh_size;
+        const bool isSorted = sectionRelocPlan.flags & VPU_SHF_RELA_SORTED;
+        for (const auto& run : sectionRelocPlan.runs) {
+            const auto patchSize = utils::getRelocationPatchSize(run.type);
+            VPU_PackedRelocationAEntry packedRun{};
+            packedRun.r_offset = run.offset;
+            packedRun.r_count = run.count;
+            packedRun.r_stride = run.stride;
+            if (run.patchSize != patchSize || (isSorted && !patchSize) ||
+                !isRelocationRunInBounds(packedRun, patchSize, targetSectionSize) ||
+                run.symIdx >= sectionRelocPlan.symbolsCount || (isJit && run.symIdx == 0)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void VPUXLoader::checkRuntimeSymTabs() const {
+    VPUX_ELF_THROW_WHEN(m_runtimeSymTabs.size() < m_relocationPlan->runtimeSymbolsCount, ArgsError,
+                        "Runtime symbol table is smaller than required by the relocations");
+}
+
 void VPUXLoader::updateSharedBuffers(const std::vector<std::size_t>& relocationSectionIndexes) {
     VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Update shared buffers");
 
@@ -798,7 +1410,15 @@ void VPUXLoader::updateSharedBuffers(const std::vector<std::size_t>& relocationS
 }
 
 void VPUXLoader::loadBuffers() {
+    if (m_segmentAllocations) {
+        allocateSegmentBuffers();
+    }
+    if (m_arenaAllocations) {
+        allocateArenaBuffers();
+    }
+
     // Now actually create and load buffers
+    std::vector<size_t> loadedSections;
     for (auto& elem : m_inferBufferContainer) {
         auto bufferIndex = elem.first;
         auto& bufferInfo = elem.second;
@@ -807,301 +1427,736 @@ void VPUXLoader::loadBuffers() {
             auto& section = m_reader->getSection(bufferIndex);
 
             if (bufferInfo.mBufferDetails.mIsShared) {
-                bufferInfo.mBuffer = m_reader->getSection(bufferIndex).getDataBuffer();
+                if (m_sharedSectionDeduplication) {
+                    bufferInfo.mBuffer = getDeduplicatedSectionBuffer(bufferIndex);
+                } else if (isStreamedSection(bufferIndex)) {
+                    bufferInfo.mBuffer = buildStreamedSectionBuffer(bufferIndex);
+                } else {
+                    bufferInfo.mBuffer = section.getDataBuffer();
+                }
             } else {
-                // Initialize backup buffer info
-                auto& backupBufferInfo = m_backupBufferContainer.safeInitBufferInfoAtIndex(bufferIndex);
-
-                // Get actual backup buffer with CPU-only access
-                backupBufferInfo.mBuffer = m_reader->getSection(bufferIndex).getDataBuffer(true);
-                auto backupBufferLock = ElfBufferLockGuard(backupBufferInfo.mBuffer.get());
-                // Explicitly allocate a new NPU-access buffer
-                auto bufferSpecs = backupBufferInfo.mBuffer->getBufferSpecs();
-                bufferSpecs.procFlags = section.getHeader()->sh_flags;
-                bufferInfo.mBuffer = m_inferBufferContainer.buildAllocatedDeviceBuffer(bufferSpecs);
-
-                // Copy data from backup to infer buffer
-                bufferInfo.mBuffer->loadWithLock(backupBufferInfo.mBuffer->getBuffer().cpu_addr(),
-                                                 backupBufferInfo.mBuffer->getBuffer().size());
-
-                backupBufferInfo.mBufferDetails.mHasData = true;
-                backupBufferInfo.mBufferDetails.mIsShared = true;
-                backupBufferInfo.mBufferDetails.mIsProcessed = true;
+                // Without backups, the pristine section bytes are read again from the AccessManager when needed
+                if (!m_backupFreeReload) {
+                    // Initialize backup buffer info
+                    auto& backupBufferInfo = m_backupBufferContainer.safeInitBufferInfoAtIndex(bufferIndex);
+
+                    // Get actual backup buffer with CPU-only access, the load pipeline reads it on its own
+                    if (!m_pipelinedLoad) {
+                        backupBufferInfo.mBuffer = m_reader->getSection(bufferIndex).getDataBuffer(true);
+                    }
+                    backupBufferInfo.mBufferDetails.mHasData = true;
+                    backupBufferInfo.mBufferDetails.mIsShared = true;
+                    backupBufferInfo.mBufferDetails.mIsProcessed = true;
+                }
+
+                // Explicitly allocate a new NPU-access buffer, unless it was sub-allocated from an arena or will be
+                // allocated by the load pipeline
+                if (!bufferInfo.mBuffer && !m_pipelinedLoad) {
+                    bufferInfo.mBuffer =
+                            m_inferBufferContainer.buildAllocatedDeviceBuffer(getSectionBufferSpecs(bufferIndex));
+                }
+
+                loadedSections.push_back(bufferIndex);
             }
 
             bufferInfo.mBufferDetails.mIsProcessed = true;
         }
     }
-}
-
-void VPUXLoader::reloadNewBuffers() {
-    for (const auto& buffer : m_inferBufferContainer) {
-        auto& sectionIndex = buffer.first;
-        auto& inferBufferInfo = buffer.second;
-        if (inferBufferInfo.mBufferDetails.mHasData && !inferBufferInfo.mBufferDetails.mIsShared) {
-            auto& backupBufferInfo = m_backupBufferContainer.getBufferInfoFromIndex(sectionIndex);
-            auto backupBufferLock = ElfBufferLockGuard(backupBufferInfo.mBuffer.get());
 
-            VPUX_ELF_THROW_UNLESS(
-                    backupBufferInfo.mBuffer->getBuffer().size() == inferBufferInfo.mBuffer->getBuffer().size(),
-                    RuntimeError, "Mismatch between section backup size and allocated device buffer size");
-            inferBufferInfo.mBuffer->loadWithLock(backupBufferInfo.mBuffer->getBuffer().cpu_addr(),
-                                                  inferBufferInfo.mBuffer->getBuffer().size());
-            VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Loading with lock %llu bytes from %p to %p",
-                         inferBufferInfo.mBuffer->getBuffer().size(), backupBufferInfo.mBuffer->getBuffer().cpu_addr(),
-                         inferBufferInfo.mBuffer->getBuffer().cpu_addr());
-        }
+    if (m_pipelinedLoad) {
+        runLoadPipeline(loadedSections);
+        return;
     }
+
+    // Copy data from the backups (or the AccessManager) to the infer buffers
+    reloadBuffers(loadedSections);
 }
 
-void VPUXLoader::applyRelocations(const std::vector<std::size_t>& relocationSectionIndexes) {
-    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "apply relocations");
-    for (const auto& relocationSectionIdx : relocationSectionIndexes) {
-        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "applying relocation section %u", relocationSectionIdx);
+void VPUXLoader::runLoadPipeline(const std::vector<size_t>& loadedSections) {
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Run load pipeline for %zu sections", loadedSections.size());
+    const auto sectionsCount = loadedSections.size();
+    const auto numSections = m_reader->getSectionsNum();
 
-        const auto& relocSection = m_reader->getSection(relocationSectionIdx);
-        auto relocations = relocSection.getData<elf::RelocationAEntry>();
-        auto relocSecHdr = relocSection.getHeader();
-        auto numRelocs = relocSection.getEntriesNum();
-
-        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tRelA section with %zu elements at addr %p", numRelocs, relocations);
-        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tRelA section info, link flags 0x%x %u 0x%llx", relocSecHdr->sh_info,
-                     relocSecHdr->sh_link, relocSecHdr->sh_flags);
-
-        // At this point we assume that all the section indexes passed to this method
-        // are containing a section of sh_type == SHT_RELA. So, the sh_link
-        // must point only to a section header index of the associated symbol table or to the reserved
-        // symbol range of sections.
-        auto symTabIdx = relocSecHdr->sh_link;
-        VPUX_ELF_THROW_UNLESS((symTabIdx < m_reader->getSectionsNum() || (symTabIdx == VPU_RT_SYMTAB)), RangeError,
-                              "sh_link exceeds the number of entries.")
+    // Reader::getSection fills its section cache lazily, which is not thread-safe. Every section is cached here,
+    // before the stages start, so that the stages and this thread only look sections up
+    for (size_t sectionIdx = 0; sectionIdx < numSections; ++sectionIdx) {
+        m_reader->getSection(sectionIdx);
+    }
 
-        // by convention, we will assume symTabIdx==VPU_RT_SYMTAB to be the "built-in" symtab
-        auto getSymTab = [&](size_t& symTabEntries) -> const SymbolEntry* {
-            if (symTabIdx == VPU_RT_SYMTAB) {
-                return m_runtimeSymTabs.data();
+    // Relocations of a section are applied as soon as it is resident and the sections its symbols refer to have an
+    // address. Only the sections of loadedSections get their address during the pipeline, in loadedSections order, so
+    // a relocation section waits for the first requiredAllocations of them
+    std::vector<size_t> allocationOrder(numSections, 0);
+    for (size_t loadedIdx = 0; loadedIdx < sectionsCount; ++loadedIdx) {
+        allocationOrder[loadedSections[loadedIdx]] = loadedIdx + 1;
+    }
+
+    struct PendingRelocations {
+        std::vector<size_t> relocationSectionIndexes;
+        size_t requiredAllocations = 0;
+    };
+    std::map<size_t /*target section index*/, PendingRelocations> pendingRelocations;
+    if (m_sharedScratchBuffers.empty()) {
+        std::map<Elf_Word /*symtab section index*/, size_t /*required allocations*/> symTabRequirements;
+        for (const auto& relocationSectionIdx : *m_relocationSectionIndexes) {
+            const auto& sectionPlan = m_relocationPlan->sections.at(relocationSectionIdx);
+            auto& targetRelocations = pendingRelocations[sectionPlan.targetSectionIdx];
+            targetRelocations.relocationSectionIndexes.push_back(relocationSectionIdx);
+
+            if (sectionPlan.symTabIdx == VPU_RT_SYMTAB) {
+                continue;
             }
+            auto symTabRequirement = symTabRequirements.find(sectionPlan.symTabIdx);
+            if (symTabRequirement == symTabRequirements.end()) {
+                const auto& symTabSection = m_reader->getSection(sectionPlan.symTabIdx);
+                const auto symbols = symTabSection.getData<elf::SymbolEntry>();
+                size_t requiredAllocations = 0;
+                for (size_t symbolIdx = 0; symbolIdx < symTabSection.getEntriesNum(); ++symbolIdx) {
+                    if (symbols[symbolIdx].st_shndx < numSections) {
+                        requiredAllocations =
+                                std::max(requiredAllocations, allocationOrder[symbols[symbolIdx].st_shndx]);
+                    }
+                }
+                symTabRequirement = symTabRequirements.emplace(sectionPlan.symTabIdx, requiredAllocations).first;
+            }
+            targetRelocations.requiredAllocations =
+                    std::max(targetRelocations.requiredAllocations, symTabRequirement->second);
+        }
+    }
 
-            const auto& symTabSection = m_reader->getSection(symTabIdx);
-            auto symTabSectionHdr = symTabSection.getHeader();
-            symTabEntries = symTabSection.getEntriesNum();
+    // The stages process the sections in loadedSections order, each of them at most m_maxSectionsInFlight sections
+    // ahead of the upload
+    std::mutex mutex;
+    std::condition_variable progress;
+    size_t allocatedCount = 0;
+    size_t readCount = 0;
+    size_t uploadedCount = 0;
+    bool aborted = false;
+    std::exception_ptr stageError;
+
+    auto runStage = [&](size_t& stageCount, const auto& processSection) {
+        try {
+            for (size_t sectionIdx = 0; sectionIdx < sectionsCount; ++sectionIdx) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    progress.wait(lock, [&]() {
+                        return aborted || stageCount - uploadedCount < m_maxSectionsInFlight;
+                    });
+                    if (aborted) {
+                        return;
+                    }
+                }
 
-            VPUX_ELF_THROW_UNLESS(checkSectionType(symTabSectionHdr, elf::SHT_SYMTAB), RelocError,
-                                  "Reloc section pointing to snon-symtab");
+                processSection(loadedSections[sectionIdx]);
 
-            return symTabSection.getData<elf::SymbolEntry>();
-        };
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ++stageCount;
+                }
+                progress.notify_all();
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stageError = std::current_exception();
+                aborted = true;
+            }
+            progress.notify_all();
+        }
+    };
 
-        size_t symTabEntries = 0;
-        auto symTabs = getSymTab(symTabEntries);
+    // Explicitly allocate the NPU-access buffers, unless they were sub-allocated from an arena
+    std::thread allocator([&]() {
+        ScopedNumaAffinity numaAffinity(m_numaNode);
+        runStage(allocatedCount, [&](size_t sectionIndex) {
+            auto& bufferInfo = m_inferBufferContainer.getBufferInfoFromIndex(sectionIndex);
+            if (!bufferInfo.mBuffer) {
+                bufferInfo.mBuffer =
+                        m_inferBufferContainer.buildAllocatedDeviceBuffer(getSectionBufferSpecs(sectionIndex));
+            }
+        });
+    });
+
+    // Read the backups with CPU-only access, without backups the upload reads from the AccessManager itself
+    std::thread reader;
+    if (!m_backupFreeReload) {
+        reader = std::thread([&]() {
+            ScopedNumaAffinity numaAffinity(m_numaNode);
+            runStage(readCount, [&](size_t sectionIndex) {
+                m_backupBufferContainer.getBufferInfoFromIndex(sectionIndex).mBuffer =
+                        m_reader->getSection(sectionIndex).getDataBuffer(true);
+            });
+        });
+    }
 
-        auto relocSecFlags = relocSecHdr->sh_flags;
-        Elf_Word targetSectionIdx = 0;
-        if (relocSecFlags & SHF_INFO_LINK) {
-            targetSectionIdx = relocSecHdr->sh_info;
-        } else {
-            VPUX_ELF_THROW(RelocError,
-                           "Rela section with no target section");
-            return;
+    auto stopStages = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            aborted = true;
         }
+        progress.notify_all();
+        allocator.join();
+        if (reader.joinable()) {
+            reader.join();
+        }
+    };
 
-        VPUX_ELF_THROW_WHEN(targetSectionIdx == 0 || targetSectionIdx > m_reader->getSectionsNum(), RelocError,
-                            "invalid target section from rela section");
+    try {
+        std::vector<bool> pendingUploads(numSections, false);
+        for (const auto& sectionIndex : loadedSections) {
+            pendingUploads[sectionIndex] = true;
+        }
 
-        auto targetSection = m_reader->getSection(targetSectionIdx);
+        // the symbol tables are resolved once the sections they refer to have an address
+        m_resolvedSymbolTables.clear();
+        auto applyResidentRelocations = [&](size_t allocated) {
+            for (auto relocations = pendingRelocations.begin(); relocations != pendingRelocations.end();) {
+                const auto& targetRelocations = relocations->second;
+                if (pendingUploads[relocations->first] || targetRelocations.requiredAllocations > allocated) {
+                    ++relocations;
+                    continue;
+                }
+                for (const auto& relocationSectionIdx : targetRelocations.relocationSectionIndexes) {
+                    resolveSymbolTable(m_relocationPlan->sections.at(relocationSectionIdx).symTabIdx);
+                }
+                applyRelocations(targetRelocations.relocationSectionIndexes);
+                relocations = pendingRelocations.erase(relocations);
+            }
+        };
 
-        // at this point we assume that all sections have an address, to which we can apply a simple lookup
-        auto& targetSectionBuf = m_inferBufferContainer.getBufferInfoFromIndex(targetSectionIdx).mBuffer;
-        auto targetSectionLock = ElfBufferLockGuard(targetSectionBuf.get());
+        size_t uploaded = 0;
+        while (uploaded < sectionsCount) {
+            size_t ready = 0;
+            size_t allocated = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                auto readyCount = [&]() {
+                    return m_backupFreeReload ? allocatedCount : std::min(allocatedCount, readCount);
+                };
+                progress.wait(lock, [&]() {
+                    return aborted || readyCount() > uploaded;
+                });
+                if (aborted) {
+                    break;
+                }
+                ready = readyCount();
+                allocated = allocatedCount;
+            }
 
-        auto targetSectionAddr = targetSectionBuf->getBuffer().cpu_addr();
-        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "Relocations are targeting section at addr %p named %s", targetSectionAddr,
-                     targetSection.getName());
+            // Every section both allocated and read so far is uploaded with a single batch
+            std::vector<size_t> uploads(loadedSections.begin() + uploaded, loadedSections.begin() + ready);
+            reloadBuffers(uploads);
+            for (const auto& sectionIndex : uploads) {
+                pendingUploads[sectionIndex] = false;
+            }
+            uploaded = ready;
 
-        // apply the actual relocations
-        for (size_t relocIdx = 0; relocIdx < numRelocs; ++relocIdx) {
-            const elf::RelocationAEntry& relocation = relocations[relocIdx];
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                uploadedCount = uploaded;
+            }
+            progress.notify_all();
 
-            auto relOffset = relocation.r_offset;
+            applyResidentRelocations(allocated);
+        }
 
-            VPUX_ELF_THROW_UNLESS(relOffset < targetSectionBuf->getBuffer().size(), RelocError,
-                                  "RelocOffset outside of the section size");
+        allocator.join();
+        if (reader.joinable()) {
+            reader.join();
+        }
+        if (stageError) {
+            std::rethrow_exception(stageError);
+        }
 
-            auto relSymIdx = elf64RSym(relocation.r_info);
+        // every section has an address now
+        applyResidentRelocations(sectionsCount);
+    } catch (...) {
+        if (allocator.joinable()) {
+            stopStages();
+        }
+        throw;
+    }
+}
 
-            // there are two types of relocation that can be suported at this point
-            //    - special relocation that would use the runtime symbols
-            // received from the user
-            //    - relocations on the symbols defined in the symbol table inside the ELF file.
-            // In this case the section has a specific number of entries (need to use the getEntriesNum method of
-            // this section)
-            VPUX_ELF_THROW_WHEN((relSymIdx > symTabEntries && symTabIdx != VPU_RT_SYMTAB) ||
-                                        (relSymIdx > m_runtimeSymTabs.size() && symTabIdx == VPU_RT_SYMTAB),
-                                RelocError, "SymTab index out of bounds!");
+void VPUXLoader::allocateArenaBuffers() {
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Allocate arena buffers");
+
+    // Sections still needing an NPU-access buffer: the deferred Allocate ones and the non-shared AllocateAndLoad ones
+    // sections with different placement hints may want different memory, so they don't share an arena
+    std::map<std::pair<Elf_Xword /*section flags*/, PlacementHints>, std::vector<size_t> /*section index*/>
+            arenaSections;
+    for (const auto& elem : m_inferBufferContainer) {
+        const auto& bufferInfo = elem.second;
+        const bool isDeferred = !bufferInfo.mBufferDetails.mHasData && !bufferInfo.mBuffer;
+        const bool isLoaded = bufferInfo.mBufferDetails.mHasData && !bufferInfo.mBufferDetails.mIsShared &&
+                              !bufferInfo.mBufferDetails.mIsProcessed && !bufferInfo.mBuffer;
+        if (isDeferred || isLoaded) {
+            arenaSections[{m_reader->getSection(elem.first).getHeader()->sh_flags, m_placementHints[elem.first]}]
+                    .push_back(elem.first);
+        }
+    }
 
-            auto relType = elf64RType(relocation.r_info);
-            auto addend = relocation.r_addend;
+    for (const auto& arenaClass : arenaSections) {
+        const auto sectionFlags = arenaClass.first.first;
+        const auto placementHints = arenaClass.first.second;
+
+        std::vector<uint64_t> offsets;
+        offsets.reserve(arenaClass.second.size());
+        uint64_t arenaSize = 0;
+        uint64_t arenaAlignment = 1;
+        for (const auto& sectionIdx : arenaClass.second) {
+            const auto sectionHeader = m_reader->getSection(sectionIdx).getHeader();
+            const auto sectionAlignment = std::max<uint64_t>(sectionHeader->sh_addralign, 1);
+            VPUX_ELF_THROW_UNLESS(utils::isPowerOfTwo(sectionAlignment), SectionError,
+                                  "Section alignment is not a power of 2");
+
+            arenaSize = utils::alignUp(arenaSize, sectionAlignment);
+            offsets.push_back(arenaSize);
+            arenaSize += sectionHeader->sh_size;
+            arenaAlignment = std::max(arenaAlignment, sectionAlignment);
+        }
 
-            auto reloc = relocationMap.find(static_cast<RelocationType>(relType));
-            VPUX_ELF_THROW_WHEN(reloc == relocationMap.end() || reloc->second == nullptr, RelocError,
-                                "Invalid relocation type detected");
+        auto arena = std::make_shared<DeviceBufferArena>(
+                m_bufferManager, BufferSpecs(arenaAlignment, arenaSize, sectionFlags, placementHints));
+        for (size_t arenaSectionIdx = 0; arenaSectionIdx < arenaClass.second.size(); ++arenaSectionIdx) {
+            const auto sectionIdx = arenaClass.second[arenaSectionIdx];
+            const auto sectionHeader = m_reader->getSection(sectionIdx).getHeader();
+            m_inferBufferContainer.getBufferInfoFromIndex(sectionIdx).mBuffer = std::make_shared<ArenaBufferView>(
+                    arena, offsets[arenaSectionIdx],
+                    BufferSpecs(sectionHeader->sh_addralign, sectionHeader->sh_size, sectionFlags, placementHints));
+        }
 
-            auto relocFunc = reloc->second;
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tArena of %zu sections with flags 0x%llx, size %llu",
+                     arenaClass.second.size(), sectionFlags, arenaSize);
+    }
+}
 
-            // the actual data that we need to modify
-            auto relocationTargetAddr = targetSectionAddr + relOffset;
+void VPUXLoader::allocateSegmentBuffers() {
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Allocate segment buffers");
 
-            // deliberate copy so we don't modify the contents of the original elf.
-            elf::SymbolEntry targetSymbol = symTabs[relSymIdx];
-            auto symbolTargetSectionIdx = targetSymbol.st_shndx;
+    for (size_t segmentIdx = 0; segmentIdx < m_reader->getSegmentsNum(); ++segmentIdx) {
+        const auto segment = m_reader->getSegment(segmentIdx);
+        if (segment->p_type != PT_LOAD || !segment->p_memsz) {
+            continue;
+        }
 
-            uint64_t symValue = 0;
-            if (m_inferBufferContainer.hasBufferInfoAtIndex(symbolTargetSectionIdx)) {
-                symValue = m_inferBufferContainer.getBufferInfoFromIndex(symbolTargetSectionIdx)
-                                   .mBuffer->getBuffer()
-                                   .vpu_addr();
+        // Sections of the segment still needing an NPU-access buffer: the shared ones, which are loaded here, or the
+        // deferred Allocate and the non-shared AllocateAndLoad ones, which are loaded later like the arena sections
+        std::vector<size_t> sharedSections;
+        std::vector<size_t> ownedSections;
+        for (const auto& elem : m_inferBufferContainer) {
+            const auto sectionHeader = m_reader->getSection(elem.first).getHeader();
+            if (!sectionHeader->sh_size || sectionHeader->sh_addr < segment->p_vaddr ||
+                sectionHeader->sh_addr - segment->p_vaddr >= segment->p_memsz) {
+                continue;
             }
-            if (symValue || symTabIdx == VPU_RT_SYMTAB) {
-                targetSymbol.st_value += symValue;
-            } else {
-                auto sectionType = m_reader->getSection(symbolTargetSectionIdx).getHeader()->sh_type;
+            VPUX_ELF_THROW_WHEN(sectionHeader->sh_size > segment->p_memsz - (sectionHeader->sh_addr - segment->p_vaddr),
+                                SectionError, "Section exceeds its segment");
 
-                size_t index = -1;
-                for (index = 0; index < m_symbolSectionTypes.size(); ++index) {
-                    if (m_symbolSectionTypes[index] == sectionType) {
-                        break;
-                    }
-                }
+            const auto& bufferInfo = elem.second;
+            if (bufferInfo.mBuffer && !bufferInfo.mBufferDetails.mIsShared) {
+                // e.g. sharable scratch sections, they keep their own allocation
+                continue;
+            }
+            if (bufferInfo.mBufferDetails.mIsShared && !bufferInfo.mBufferDetails.mIsProcessed) {
+                sharedSections.push_back(elem.first);
+            } else if (!bufferInfo.mBufferDetails.mHasData || !bufferInfo.mBufferDetails.mIsProcessed) {
+                ownedSections.push_back(elem.first);
+            }
+        }
 
-                // error if index still -1
+        if (sharedSections.empty() == ownedSections.empty()) {
+            if (!sharedSections.empty()) {
+                VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tSegment %zu mixes shared and loader owned sections, skipped",
+                             segmentIdx);
+            }
+            continue;
+        }
+
+        const auto& segmentSections = sharedSections.empty() ? ownedSections : sharedSections;
+        const auto firstSectionHeader = m_reader->getSection(segmentSections.front()).getHeader();
+        const auto sectionFlags = firstSectionHeader->sh_flags;
+        const auto placementHints = m_placementHints[segmentSections.front()];
+
+        // the arena only spans the sections placed in it, the others (e.g. sharable scratch) keep their own buffers
+        uint64_t segmentAlignment = std::max<uint64_t>(segment->p_align, 1);
+        uint64_t sectionsAlignment = 1;
+        uint64_t placedBegin = segment->p_memsz;
+        uint64_t placedEnd = 0;
+        bool isUniform = true;
+        for (const auto& sectionIdx : segmentSections) {
+            const auto sectionHeader = m_reader->getSection(sectionIdx).getHeader();
+            isUniform &= sectionHeader->sh_flags == sectionFlags && m_placementHints[sectionIdx] == placementHints;
+
+            const auto sectionAlignment = std::max<uint64_t>(sectionHeader->sh_addralign, 1);
+            VPUX_ELF_THROW_UNLESS(utils::isPowerOfTwo(sectionAlignment), SectionError,
+                                  "Section alignment is not a power of 2");
+            VPUX_ELF_THROW_WHEN((sectionHeader->sh_addr - segment->p_vaddr) % sectionAlignment, SectionError,
+                                "Section misaligned inside its segment");
+            segmentAlignment = std::max(segmentAlignment, sectionAlignment);
+            sectionsAlignment = std::max(sectionsAlignment, sectionAlignment);
+            placedBegin = std::min(placedBegin, sectionHeader->sh_addr - segment->p_vaddr);
+            placedEnd = std::max(placedEnd, sectionHeader->sh_addr - segment->p_vaddr + sectionHeader->sh_size);
+
+            // the shared sections are uploaded with the file bytes of the segment
+            VPUX_ELF_THROW_WHEN(!sharedSections.empty() &&
+                                        (sectionHeader->sh_addr - segment->p_vaddr + segment->p_offset !=
+                                                 sectionHeader->sh_offset ||
+                                         sectionHeader->sh_addr - segment->p_vaddr + sectionHeader->sh_size >
+                                                 segment->p_filesz),
+                                SectionError, "Section file layout doesn't match its segment");
+        }
 
-                targetSymbol = m_runtimeSymTabs[index];
+        // the memory the sections want is told by their flags and placement hints, which must then be the same
+        if (!isUniform) {
+            VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tSegment %zu mixes section flags or placement hints, skipped",
+                         segmentIdx);
+            continue;
+        }
+
+        // the arena starts at the first placed section, aligned down so that the offsets of the views keep the
+        // alignment of their sections
+        const auto arenaBase = placedBegin & ~(sectionsAlignment - 1);
+        const auto arenaSize = placedEnd - arenaBase;
+        auto arena = std::make_shared<DeviceBufferArena>(
+                m_bufferManager, BufferSpecs(segmentAlignment, arenaSize, sectionFlags, placementHints));
+        for (const auto& sectionIdx : segmentSections) {
+            const auto sectionHeader = m_reader->getSection(sectionIdx).getHeader();
+            m_inferBufferContainer.getBufferInfoFromIndex(sectionIdx).mBuffer = std::make_shared<ArenaBufferView>(
+                    arena, sectionHeader->sh_addr - segment->p_vaddr - arenaBase,
+                    BufferSpecs(sectionHeader->sh_addralign, sectionHeader->sh_size, sectionFlags, placementHints));
+        }
+
+        if (!sharedSections.empty()) {
+            // the shared sections are inside the file bytes of the segment, checked above, so is the whole arena
+            ArenaBufferView segmentData(arena, 0,
+                                        BufferSpecs(segmentAlignment, arenaSize, sectionFlags, placementHints));
+            m_accessor->readExternal(segment->p_offset + arenaBase, segmentData);
+            for (const auto& sectionIdx : sharedSections) {
+                m_inferBufferContainer.getBufferInfoFromIndex(sectionIdx).mBufferDetails.mIsProcessed = true;
             }
+        }
+
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tSegment %zu of %zu %s sections with flags 0x%llx, size %llu", segmentIdx,
+                     segmentSections.size(), sharedSections.empty() ? "owned" : "shared", sectionFlags, arenaSize);
+    }
 
-            VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\t\tApplying Relocation at offset %llu symidx %u reltype %u addend %llu",
-                         relOffset, relSymIdx, relType, addend);
+    if (m_arenaAllocations) {
+        return;
+    }
 
-            relocFunc((void*)relocationTargetAddr, targetSymbol, addend);
+    // the deferred Allocate sections out of the segments
+    for (auto& elem : m_inferBufferContainer) {
+        auto& bufferInfo = elem.second;
+        if (!bufferInfo.mBufferDetails.mHasData && !bufferInfo.mBuffer) {
+            bufferInfo.mBuffer = m_inferBufferContainer.buildAllocatedDeviceBuffer(getSectionBufferSpecs(elem.first));
         }
     }
+}
 
-    return;
-};
+void VPUXLoader::reloadNewBuffers() {
+    reloadBuffers(getReloadedSections());
+}
 
-void VPUXLoader::applyJitRelocations(std::vector<DeviceBuffer>& inputs, std::vector<DeviceBuffer>& outputs,
-                                     std::vector<DeviceBuffer>& profiling) {
-    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "apply JITrelocations");
-    for (const auto& relocationSectionIdx : *m_jitRelocations) {
-        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tapplying JITrelocation section %u", relocationSectionIdx);
+std::vector<size_t> VPUXLoader::getReloadedSections() const {
+    std::vector<size_t> reloadedSections;
+    for (const auto& buffer : m_inferBufferContainer) {
+        const auto& inferBufferInfo = buffer.second;
+        if (inferBufferInfo.mBufferDetails.mHasData && !inferBufferInfo.mBufferDetails.mIsShared) {
+            reloadedSections.push_back(buffer.first);
+        }
+    }
+    return reloadedSections;
+}
 
-        const auto& relocSection = m_reader->getSection(relocationSectionIdx);
-        auto relocations = relocSection.getData<elf::RelocationAEntry>();
-        auto relocSecHdr = relocSection.getHeader();
-        auto numRelocs = relocSection.getEntriesNum();
-
-        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tJitRelA section with %zu elements at addr %p", numRelocs, relocations);
-        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tJitRelA section info, link flags 0x%x %u 0x%llx", relocSecHdr->sh_info,
-                     relocSecHdr->sh_link, relocSecHdr->sh_flags);
-
-        // At this point we assume that all the section indexes passed to this method
-        // are containing a section of sh_type == SHT_RELA. So, the sh_link
-        // must point only to a section header index of the associated symbol table.
-        auto symTabIdx = relocSecHdr->sh_link;
-        VPUX_ELF_THROW_UNLESS(symTabIdx < m_reader->getSectionsNum(), RangeError,
-                              "sh_link exceeds the number of entries.");
-
-        // in JitRelocations case, we will expect to point to either "VPUX_USER_INPUT" or "VPUX_USER_INPUT" symtabs
-        VPUX_ELF_THROW_WHEN(symTabIdx == VPU_RT_SYMTAB, RelocError, "JitReloc pointing to runtime symtab idx");
-
-        const auto& symTabSection = m_reader->getSection(symTabIdx);
-        auto symTabSectionHdr = symTabSection.getHeader();
-
-        VPUX_ELF_THROW_UNLESS(checkSectionType(symTabSectionHdr, elf::SHT_SYMTAB), RelocError,
-                              "Reloc section pointing to non-symtab");
-
-        auto symTabSize = symTabSection.getEntriesNum();
-        auto symTabs = symTabSection.getData<elf::SymbolEntry>();
-
-        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tSymTabIdx %u symTabSize %zu at %p", symTabIdx, symTabSize, symTabs);
-
-        auto relocSecFlags = relocSecHdr->sh_flags;
-        auto getUserAddrs = [&]() -> std::vector<DeviceBuffer> {
-            if (relocSecFlags & VPU_SHF_USERINPUT) {
-                return std::vector<DeviceBuffer>(inputs);
-            } else if (relocSecFlags & VPU_SHF_USEROUTPUT) {
-                return std::vector<DeviceBuffer>(outputs);
-            } else if (relocSecFlags & VPU_SHF_PROFOUTPUT) {
-                return std::vector<DeviceBuffer>(profiling);
-            } else {
-                VPUX_ELF_THROW(RelocError, "Jit reloc section pointing neither to userInput nor userOutput");
-                return std::vector<DeviceBuffer>(outputs);
+std::vector<ManagedBuffer*> VPUXLoader::getWorkingSet(const std::vector<size_t>& reloadedSections,
+                                                      const std::vector<std::size_t>& relocationSectionIndexes) {
+    std::vector<ManagedBuffer*> workingSet;
+    workingSet.reserve(2 * reloadedSections.size() + relocationSectionIndexes.size());
+
+    for (const auto& sectionIndex : reloadedSections) {
+        workingSet.push_back(m_inferBufferContainer.getBufferInfoFromIndex(sectionIndex).mBuffer.get());
+        if (m_backupBufferContainer.hasBufferInfoAtIndex(sectionIndex)) {
+            workingSet.push_back(m_backupBufferContainer.getBufferInfoFromIndex(sectionIndex).mBuffer.get());
+        }
+    }
+
+    for (const auto& relocationSectionIdx : relocationSectionIndexes) {
+        const auto targetSectionIdx = m_relocationPlan->sections.at(relocationSectionIdx).targetSectionIdx;
+        workingSet.push_back(m_inferBufferContainer.getBufferInfoFromIndex(targetSectionIdx).mBuffer.get());
+    }
+
+    // a buffer may be listed several times, every occurrence is a lock count
+    std::sort(workingSet.begin(), workingSet.end());
+    workingSet.erase(std::unique(workingSet.begin(), workingSet.end()), workingSet.end());
+    return workingSet;
+}
+
+void VPUXLoader::reloadBuffers(const std::vector<size_t>& sectionIndexes) {
+    auto workingSetLock = ElfBufferBatchLockGuard(getWorkingSet(sectionIndexes, {}));
+
+    if (m_backupFreeReload) {
+        for (const auto& sectionIndex : sectionIndexes) {
+            auto& inferBufferInfo = m_inferBufferContainer.getBufferInfoFromIndex(sectionIndex);
+            const auto sectionHeader = m_reader->getSection(sectionIndex).getHeader();
+            VPUX_ELF_THROW_UNLESS(sectionHeader->sh_size == inferBufferInfo.mBuffer->getBuffer().size(), RuntimeError,
+                                  "Mismatch between section size and allocated device buffer size");
+            m_accessor->readExternal(sectionHeader->sh_offset, *inferBufferInfo.mBuffer);
+            VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Reading %llu bytes from offset %llu to %p", sectionHeader->sh_size,
+                         sectionHeader->sh_offset, inferBufferInfo.mBuffer->getBuffer().cpu_addr());
+        }
+        return;
+    }
+
+    std::vector<ManagedBuffer::LoadRequest> loads;
+    loads.reserve(sectionIndexes.size());
+    for (const auto& sectionIndex : sectionIndexes) {
+        auto& inferBufferInfo = m_inferBufferContainer.getBufferInfoFromIndex(sectionIndex);
+        auto& backupBufferInfo = m_backupBufferContainer.getBufferInfoFromIndex(sectionIndex);
+
+        VPUX_ELF_THROW_UNLESS(
+                backupBufferInfo.mBuffer->getBuffer().size() == inferBufferInfo.mBuffer->getBuffer().size(),
+                RuntimeError, "Mismatch between section backup size and allocated device buffer size");
+        loads.push_back({inferBufferInfo.mBuffer.get(), backupBufferInfo.mBuffer->getBuffer().cpu_addr(),
+                         inferBufferInfo.mBuffer->getBuffer().size()});
+        VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Loading %llu bytes from %p to %p",
+                     inferBufferInfo.mBuffer->getBuffer().size(), backupBufferInfo.mBuffer->getBuffer().cpu_addr(),
+                     inferBufferInfo.mBuffer->getBuffer().cpu_addr());
+    }
+
+    // All the uploads are submitted at once, so that the BufferManager can chain them
+    ManagedBuffer::loadMany(loads);
+}
+
+void VPUXLoader::resolveSymbolTables(const std::vector<std::size_t>& relocationSectionIndexes) {
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Resolve symbol tables");
+    m_resolvedSymbolTables.clear();
+
+    for (const auto& relocationSectionIdx : relocationSectionIndexes) {
+        resolveSymbolTable(m_relocationPlan->sections.at(relocationSectionIdx).symTabIdx);
+    }
+}
+
+void VPUXLoader::resolveSymbolTable(elf::Elf_Word symTabIdx) {
+    // runtime symbols are used as they are received from the user
+    if (symTabIdx == VPU_RT_SYMTAB || m_resolvedSymbolTables.find(symTabIdx) != m_resolvedSymbolTables.end()) {
+        return;
+    }
+
+    const auto& symTabSection = m_reader->getSection(symTabIdx);
+    auto symbols = symTabSection.getData<elf::SymbolEntry>();
+    auto symbolsCount = symTabSection.getEntriesNum();
+
+    // deliberate copy so we don't modify the contents of the original elf.
+    auto& resolvedSymbols = m_resolvedSymbolTables[symTabIdx];
+    resolvedSymbols.assign(symbols, symbols + symbolsCount);
+    if (hasElidedProfOutputFlag(symTabIdx)) {
+        // profiling output symbols, bound to the dummy profiling address instead of the user profiling buffers
+        for (auto& symbol : resolvedSymbols) {
+            symbol.st_value = m_profilingDummyAddress;
+        }
+        return;
+    }
+
+    // symbols no relocation refers to may be left without an address, the referenced ones must be resolved
+    std::vector<bool> isReferenced(symbolsCount);
+    for (const auto& sectionPlan : m_relocationPlan->sections) {
+        if (sectionPlan.second.symTabIdx == symTabIdx) {
+            for (const auto& run : sectionPlan.second.runs) {
+                isReferenced[run.symIdx] = true;
             }
-        };
+        }
+    }
 
-        auto userAddrs = getUserAddrs();
+    for (size_t symbolIdx = 0; symbolIdx < symbolsCount; ++symbolIdx) {
+        VPUX_ELF_THROW_WHEN(!resolveSymbol(resolvedSymbols[symbolIdx]) && isReferenced[symbolIdx], RelocError,
+                            "No runtime symbol for the section type of a relocated symbol");
+    }
 
-        Elf_Word targetSectionIdx = 0;
-        if (relocSecFlags & SHF_INFO_LINK) {
-            targetSectionIdx = relocSecHdr->sh_info;
-        } else {
-            VPUX_ELF_THROW(
-                    RelocError,
-                    "Rela section with no target section");
-            return;
+    VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tResolved %zu symbols of symtab %u", symbolsCount, symTabIdx);
+}
+
+bool VPUXLoader::resolveSymbol(elf::SymbolEntry& symbol) {
+    auto symbolTargetSectionIdx = symbol.st_shndx;
+
+    if (symbolTargetSectionIdx && hasElidedProfOutputFlag(symbolTargetSectionIdx)) {
+        symbol.st_value = m_profilingDummyAddress;
+        return true;
+    }
+
+    uint64_t symValue = 0;
+    if (m_inferBufferContainer.hasBufferInfoAtIndex(symbolTargetSectionIdx)) {
+        symValue =
+                m_inferBufferContainer.getBufferInfoFromIndex(symbolTargetSectionIdx).mBuffer->getBuffer().vpu_addr();
+    }
+
+    if (symValue) {
+        symbol.st_value += symValue;
+        return true;
+    }
+
+    // symbols of special section indexes are left untouched
+    if (symbolTargetSectionIdx >= m_reader->getSectionsNum()) {
+        return true;
+    }
+
+    // the section holding the symbol has no address assigned by the loader, so the runtime symbol associated to its
+    // section type is used instead
+    auto sectionType = m_reader->getSection(symbolTargetSectionIdx).getHeader()->sh_type;
+
+    size_t index = 0;
+    for (index = 0; index < m_symbolSectionTypes.size(); ++index) {
+        if (m_symbolSectionTypes[index] == sectionType) {
+            break;
+        }
+    }
+
+    if (index >= m_symbolSectionTypes.size() || index >= m_runtimeSymTabs.size()) {
+        return false;
+    }
+    symbol = m_runtimeSymTabs[index];
+    return true;
+}
+
+void VPUXLoader::applyRelocations(const std::vector<std::size_t>& relocationSectionIndexes) {
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "apply relocations");
+    auto workingSetLock = ElfBufferBatchLockGuard(getWorkingSet({}, relocationSectionIndexes));
+    for (const auto& relocationSectionIdx : relocationSectionIndexes) {
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "applying relocation section %u", relocationSectionIdx);
+
+        // the plan was validated by compileRelocationPlan, so no checks are needed while applying it
+        const auto& sectionPlan = m_relocationPlan->sections.at(relocationSectionIdx);
+
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tRelA section with %zu runs", sectionPlan.runs.size());
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tRelA section info, link flags 0x%x %u 0x%llx",
+                     sectionPlan.targetSectionIdx, sectionPlan.symTabIdx, sectionPlan.flags);
+
+        // by convention, we will assume symTabIdx==VPU_RT_SYMTAB to be the "built-in" symtab
+        // all the other symbol tables were resolved upfront by resolveSymbolTables
+        const std::vector<SymbolEntry>* symTab = &m_runtimeSymTabs;
+        if (sectionPlan.symTabIdx != VPU_RT_SYMTAB) {
+            auto resolvedSymTab = m_resolvedSymbolTables.find(sectionPlan.symTabIdx);
+            VPUX_ELF_THROW_WHEN(resolvedSymTab == m_resolvedSymbolTables.end(), SequenceError,
+                                "Symbol table was not resolved before applying relocations");
+            symTab = &resolvedSymTab->second;
         }
 
+        const auto symTabs = symTab->data();
+
         // at this point we assume that all sections have an address, to which we can apply a simple lookup
-        auto targetSectionBuf = m_inferBufferContainer.getBufferInfoFromIndex(targetSectionIdx).mBuffer;
+        auto& targetSectionBuf = m_inferBufferContainer.getBufferInfoFromIndex(sectionPlan.targetSectionIdx).mBuffer;
         auto targetSectionLock = ElfBufferLockGuard(targetSectionBuf.get());
 
         auto targetSectionAddr = targetSectionBuf->getBuffer().cpu_addr();
-
-        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\t targetSectionAddr %p", targetSectionAddr);
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "Relocations are targeting section at addr %p named %s", targetSectionAddr,
+                     m_reader->getSection(sectionPlan.targetSectionIdx).getName());
 
         // apply the actual relocations
-        for (size_t relocIdx = 0; relocIdx < numRelocs; ++relocIdx) {
-            VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\t Solving Reloc at %p %zu", relocations, relocIdx);
+        // offset sorted sections are patched through a staging window, see RelocationWindow
+        const bool isSorted = sectionPlan.flags & VPU_SHF_RELA_SORTED;
+        RelocationWindow window(targetSectionAddr, targetSectionBuf->getBuffer().size());
 
-            const elf::RelocationAEntry& relocation = relocations[relocIdx];
+        for (const auto& run : sectionPlan.runs) {
+            const auto& relocFunc = *run.relocFunc;
+            const elf::SymbolEntry& targetSymbol = symTabs[run.symIdx];
 
-            auto relOffset = relocation.r_offset;
+            VPUX_ELF_LOG(LogLevel::LOG_DEBUG,
+                         "\t\tApplying %u Relocations at offset %llu stride %u symidx %u addend %llu", run.count,
+                         run.offset, run.stride, run.symIdx, run.addend);
 
-            VPUX_ELF_THROW_UNLESS(relOffset < targetSectionBuf->getBuffer().size(), RelocError,
-                                  "RelocOffset outside of the section size");
+            // the actual data that we need to modify
+            auto relOffset = run.offset;
+            auto addend = run.addend;
+            for (Elf_Word relocIdx = 0; relocIdx < run.count; ++relocIdx) {
+                auto relocationTargetAddr =
+                        isSorted ? window.acquire(relOffset, run.patchSize) : targetSectionAddr + relOffset;
+                relocFunc((void*)relocationTargetAddr, targetSymbol, addend);
+
+                relOffset += run.stride;
+                addend = static_cast<Elf_Sxword>(static_cast<uint64_t>(addend) +
+                                                 static_cast<uint64_t>(run.addendStride));
+            }
+        }
 
-            auto symIdx = elf64RSym(relocation.r_info);
+        window.flush();
+    }
 
-            VPUX_ELF_THROW_WHEN(symIdx > symTabSize, RelocError, "SymTab index out of bounds!");
-            VPUX_ELF_THROW_WHEN(symIdx > userAddrs.size(), RelocError,
-                                "Invalid symbol index. It exceeds the number of relevant device buffers");
+    return;
+};
 
-            auto relType = elf64RType(relocation.r_info);
-            auto addend = relocation.r_addend;
+void VPUXLoader::applyJitRelocations(std::vector<DeviceBuffer>& inputs, std::vector<DeviceBuffer>& outputs,
+                                     std::vector<DeviceBuffer>& profiling) {
+    applyJitRelocations(*m_jitRelocations, inputs, outputs, profiling);
 
-            VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\t\t applying Reloc offset symidx reltype addend %llu %u %u %llu",
-                         relOffset, symIdx, relType, addend);
-            auto reloc = relocationMap.find(static_cast<RelocationType>(relType));
-            VPUX_ELF_THROW_WHEN(reloc == relocationMap.end() || reloc->second == nullptr, RelocError,
-                                "Invalid relocation type detected");
+    m_jitRelocationsApplied = true;
+    m_jitInputs = inputs;
+    m_jitOutputs = outputs;
+    m_jitProfiling = profiling;
+}
+
+void VPUXLoader::applyJitRelocations(const std::vector<std::size_t>& jitRelocationSectionIndexes,
+                                     std::vector<DeviceBuffer>& inputs, std::vector<DeviceBuffer>& outputs,
+                                     std::vector<DeviceBuffer>& profiling) {
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "apply JITrelocations");
+    auto workingSetLock = ElfBufferBatchLockGuard(getWorkingSet({}, jitRelocationSectionIndexes));
+    for (const auto& relocationSectionIdx : jitRelocationSectionIndexes) {
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tapplying JITrelocation section %u", relocationSectionIdx);
 
-            auto relocFunc = reloc->second;
-            auto targetAddr = targetSectionAddr + relOffset;
+        // the plan was validated by compileRelocationPlan, so no checks are needed while applying it
+        const auto& sectionPlan = m_relocationPlan->sections.at(relocationSectionIdx);
 
-            VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\t targetsectionAddr %p offs %llu result %p userAddr 0x%x symIdx %u",
-                         targetSectionAddr, relOffset, targetAddr, (uint32_t)userAddrs[symIdx - 1].vpu_addr(),
-                         symIdx - 1);
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tJitRelA section with %zu runs", sectionPlan.runs.size());
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tJitRelA section info, link flags 0x%x %u 0x%llx",
+                     sectionPlan.targetSectionIdx, sectionPlan.symTabIdx, sectionPlan.flags);
+
+        auto symTabs = m_reader->getSection(sectionPlan.symTabIdx).getData<elf::SymbolEntry>();
+
+        const std::vector<DeviceBuffer>* userAddrs = &profiling;
+        if (sectionPlan.flags & VPU_SHF_USERINPUT) {
+            userAddrs = &inputs;
+        } else if (sectionPlan.flags & VPU_SHF_USEROUTPUT) {
+            userAddrs = &outputs;
+        }
 
-            elf::SymbolEntry origSymbol = symTabs[symIdx];
+        // symbol index 0 is reserved, symbol i is bound to the user buffer i - 1
+        VPUX_ELF_THROW_WHEN(sectionPlan.symbolsCount > userAddrs->size() + 1, RelocError,
+                            "Invalid symbol index. It exceeds the number of relevant device buffers");
+
+        // at this point we assume that all sections have an address, to which we can apply a simple lookup
+        auto targetSectionBuf = m_inferBufferContainer.getBufferInfoFromIndex(sectionPlan.targetSectionIdx).mBuffer;
+        auto targetSectionLock = ElfBufferLockGuard(targetSectionBuf.get());
+
+        auto targetSectionAddr = targetSectionBuf->getBuffer().cpu_addr();
+
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\t targetSectionAddr %p", targetSectionAddr);
+
+        // apply the actual relocations
+        for (const auto& run : sectionPlan.runs) {
+            VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\t Solving %u Relocs at offset %llu", run.count, run.offset);
+
+            const auto& relocFunc = *run.relocFunc;
+            const auto& userAddr = (*userAddrs)[run.symIdx - 1];
+
+            VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\t targetsectionAddr %p offs %llu userAddr 0x%x symIdx %u",
+                         targetSectionAddr, run.offset, (uint32_t)userAddr.vpu_addr(), run.symIdx - 1);
 
             elf::SymbolEntry targetSymbol;
             targetSymbol.st_info = 0;
             targetSymbol.st_name = 0;
             targetSymbol.st_other = 0;
             targetSymbol.st_shndx = 0;
-            targetSymbol.st_value = userAddrs[symIdx - 1].vpu_addr();
-            targetSymbol.st_size = origSymbol.st_size;
+            targetSymbol.st_value = userAddr.vpu_addr();
+            targetSymbol.st_size = symTabs[run.symIdx].st_size;
+
+            auto targetAddr = targetSectionAddr + run.offset;
+            auto addend = run.addend;
+            for (Elf_Word relocIdx = 0; relocIdx < run.count; ++relocIdx) {
+                relocFunc((void*)targetAddr, targetSymbol, addend);
 
-            relocFunc((void*)targetAddr, targetSymbol, addend);
+                targetAddr += run.stride;
+                addend = static_cast<Elf_Sxword>(static_cast<uint64_t>(addend) +
+                                                 static_cast<uint64_t>(run.addendStride));
+            }
         }
     }
 }
@@ -1162,6 +2217,9 @@ std::vector<DeviceBuffer> VPUXLoader::getOutputBuffers() const {
 };
 
 std::vector<DeviceBuffer> VPUXLoader::getProfBuffers() const {
+    if (m_profilingElision) {
+        return {};
+    }
     return *m_profOutputsDescriptors.get();
 };
 
@@ -1190,19 +2248,755 @@ bool VPUXLoader::getInferencesMayBeRunInParallel() const {
     return m_inferencesMayBeRunInParallel;
 }
 
+void VPUXLoader::setArenaAllocations(bool arenaAllocations) {
+    VPUX_ELF_THROW_WHEN(m_loaded, SequenceError, "Arena mode must be set before loading");
+    m_arenaAllocations = arenaAllocations;
+}
+
+bool VPUXLoader::getArenaAllocations() const {
+    return m_arenaAllocations;
+}
+
+void VPUXLoader::setSegmentAllocations(bool segmentAllocations) {
+    VPUX_ELF_THROW_WHEN(m_loaded, SequenceError, "Segment mode must be set before loading");
+    m_segmentAllocations = segmentAllocations;
+}
+
+bool VPUXLoader::getSegmentAllocations() const {
+    return m_segmentAllocations;
+}
+
+void VPUXLoader::setBackupFreeReload(bool backupFreeReload) {
+    VPUX_ELF_THROW_WHEN(m_loaded, SequenceError, "Backup-free reload mode must be set before loading");
+    m_backupFreeReload = backupFreeReload;
+}
+
+bool VPUXLoader::getBackupFreeReload() const {
+    return m_backupFreeReload;
+}
+
+void VPUXLoader::setProfilingElision(bool profilingElision, uint64_t profilingDummyAddress) {
+    VPUX_ELF_THROW_WHEN(m_loaded, SequenceError, "Profiling elision must be set before loading");
+    m_profilingElision = profilingElision;
+    m_profilingDummyAddress = profilingDummyAddress;
+}
+
+bool VPUXLoader::getProfilingElision() const {
+    return m_profilingElision;
+}
+
+void VPUXLoader::setPipelinedLoad(bool pipelinedLoad, size_t maxSectionsInFlight) {
+    VPUX_ELF_THROW_WHEN(m_loaded, SequenceError, "Pipelined load must be set before loading");
+    VPUX_ELF_THROW_WHEN(pipelinedLoad && !maxSectionsInFlight, ArgsError, "Pipelined load needs sections in flight");
+    m_pipelinedLoad = pipelinedLoad;
+    m_maxSectionsInFlight = maxSectionsInFlight;
+}
+
+bool VPUXLoader::getPipelinedLoad() const {
+    return m_pipelinedLoad;
+}
+
+void VPUXLoader::setSharedSectionDeduplication(bool sharedSectionDeduplication) {
+    VPUX_ELF_THROW_WHEN(m_loaded, SequenceError, "Shared section deduplication must be set before loading");
+    m_sharedSectionDeduplication = sharedSectionDeduplication;
+}
+
+bool VPUXLoader::getSharedSectionDeduplication() const {
+    return m_sharedSectionDeduplication;
+}
+
+std::shared_ptr<ManagedBuffer> VPUXLoader::getDeduplicatedSectionBuffer(size_t sectionIndex) {
+    const auto& section = m_reader->getSection(sectionIndex);
+    const auto sectionHeader = section.getHeader();
+    const auto streamed = isStreamedSection(sectionIndex);
+
+    // hash a CPU-only view of the section, which emplacing AccessManagers provide without copying, or the chunks of a
+    // streamed section
+    utils::Sha256Digest digest{};
+    if (streamed) {
+        utils::Sha256 hasher;
+        streamSection(sectionIndex, [&hasher](size_t, const uint8_t* data, size_t count) {
+            hasher.update(data, count);
+        });
+        digest = hasher.finalize();
+    } else if (auto hostData = section.getDataBuffer(true)) {
+        auto hostDataLock = ElfBufferLockGuard(hostData.get());
+        digest = utils::sha256(hostData->getBuffer().cpu_addr(), hostData->getBuffer().size());
+    }
+
+    return SharedSectionRegistry::getInstance().getOrCreate(
+            {digest, sectionHeader->sh_size, sectionHeader->sh_addralign, sectionHeader->sh_flags, m_bufferManager},
+            [&]() {
+                return streamed ? buildStreamedSectionBuffer(sectionIndex) : section.getDataBuffer();
+            });
+}
+
+void VPUXLoader::setStreamingUpload(bool streamingUpload, size_t chunkSize) {
+    VPUX_ELF_THROW_WHEN(m_loaded, SequenceError, "Streaming upload must be set before loading");
+    VPUX_ELF_THROW_WHEN(streamingUpload && !chunkSize, ArgsError, "Streaming upload needs a chunk size");
+    m_streamingUpload = streamingUpload;
+    m_streamingChunkSize = chunkSize;
+}
+
+bool VPUXLoader::getStreamingUpload() const {
+    return m_streamingUpload;
+}
+
+void VPUXLoader::setNumaNode(int numaNode) {
+    VPUX_ELF_THROW_WHEN(m_loaded, SequenceError, "NUMA node must be set before loading");
+    VPUX_ELF_THROW_WHEN(numaNode < numa::NO_NUMA_NODE, ArgsError, "Invalid NUMA node");
+    m_numaNode = numaNode;
+}
+
+int VPUXLoader::getNumaNode() const {
+    return m_numaNode;
+}
+
+bool VPUXLoader::isStreamedSection(size_t sectionIndex) const {
+    const auto sectionHeader = m_reader->getSection(sectionIndex).getHeader();
+    return m_streamingUpload && sectionHeader->sh_size > m_streamingChunkSize &&
+           utils::hasNPUAccess(sectionHeader->sh_flags);
+}
+
+void VPUXLoader::streamSection(
+        size_t sectionIndex,
+        const std::function<void(size_t offset, const uint8_t* data, size_t count)>& consumeChunk) const {
+    const auto sectionHeader = m_reader->getSection(sectionIndex).getHeader();
+    const auto sectionSize = static_cast<size_t>(sectionHeader->sh_size);
+    const auto chunksCount = (sectionSize + m_streamingChunkSize - 1) / m_streamingChunkSize;
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Stream section %zu in %zu chunks", sectionIndex, chunksCount);
+
+    auto getChunkSize = [&](size_t chunkIdx) {
+        return std::min(m_streamingChunkSize, sectionSize - chunkIdx * m_streamingChunkSize);
+    };
+
+    // chunk i is read into the staging half i % 2, which is only overwritten after chunk i has been consumed
+    std::shared_ptr<HostAllocator> stagingAllocator = HostAllocator::getDefault();
+    if (m_numaNode != numa::NO_NUMA_NODE) {
+        stagingAllocator = std::make_shared<NumaHostAllocator>(m_numaNode);
+    }
+    DynamicBuffer staging(BufferSpecs(1, 2 * m_streamingChunkSize, 0, PLACEMENT_CPU_ONLY), stagingAllocator);
+    auto stagingData = staging.getBuffer().cpu_addr();
+    std::mutex mutex;
+    std::condition_variable progress;
+    size_t readCount = 0;
+    size_t consumedCount = 0;
+    bool aborted = false;
+    std::exception_ptr readError;
+
+    std::thread reader([&]() {
+        ScopedNumaAffinity numaAffinity(m_numaNode);
+        try {
+            for (size_t chunkIdx = 0; chunkIdx < chunksCount; ++chunkIdx) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    progress.wait(lock, [&]() {
+                        return aborted || chunkIdx - consumedCount < 2;
+                    });
+                    if (aborted) {
+                        return;
+                    }
+                }
+
+                StaticBuffer chunk(stagingData + (chunkIdx % 2) * m_streamingChunkSize,
+                                   BufferSpecs(0, getChunkSize(chunkIdx), 0));
+                m_accessor->readExternal(sectionHeader->sh_offset + chunkIdx * m_streamingChunkSize, chunk);
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ++readCount;
+                }
+                progress.notify_all();
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                readError = std::current_exception();
+                aborted = true;
+            }
+            progress.notify_all();
+        }
+    });
+
+    std::exception_ptr consumeError;
+    for (size_t chunkIdx = 0; chunkIdx < chunksCount; ++chunkIdx) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            progress.wait(lock, [&]() {
+                return aborted || readCount > chunkIdx;
+            });
+            if (aborted) {
+                break;
+            }
+        }
+
+        try {
+            consumeChunk(chunkIdx * m_streamingChunkSize, stagingData + (chunkIdx % 2) * m_streamingChunkSize,
+                         getChunkSize(chunkIdx));
+        } catch (...) {
+            consumeError = std::current_exception();
+            std::lock_guard<std::mutex> lock(mutex);
+            aborted = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++consumedCount;
+        }
+        progress.notify_all();
+    }
+
+    reader.join();
+    if (consumeError) {
+        std::rethrow_exception(consumeError);
+    }
+    if (readError) {
+        std::rethrow_exception(readError);
+    }
+}
+
+std::shared_ptr<ManagedBuffer> VPUXLoader::buildStreamedSectionBuffer(size_t sectionIndex) {
+    auto buffer = m_inferBufferContainer.buildAllocatedDeviceBuffer(getSectionBufferSpecs(sectionIndex));
+
+    auto bufferLock = ElfBufferLockGuard(buffer.get());
+    streamSection(sectionIndex, [&buffer](size_t offset, const uint8_t* data, size_t count) {
+        buffer->loadAt(offset, data, count);
+    });
+    return buffer;
+}
+
+namespace {
+
+Elf_Xword getProcFlags(Elf_Xword sectionFlags) {
+    return sectionFlags & (SHF_EXECINSTR | VPU_SHF_PROC_DPU | VPU_SHF_PROC_DMA | VPU_SHF_PROC_SHAVE);
+}
+
+}  // namespace
+
+MemoryUsage VPUXLoader::getMemoryUsage(bool includeShared) const {
+    MemoryUsage usage;
+    for (const auto& buffer : m_inferBufferContainer) {
+        const auto& bufferInfo = buffer.second;
+        if (!bufferInfo.mBuffer || (bufferInfo.mBufferDetails.mIsShared && !includeShared)) {
+            continue;
+        }
+
+        const auto ownedSize = bufferInfo.mBuffer->getOwnedSize();
+        (bufferInfo.mBufferDetails.mIsShared ? usage.sharedDeviceBytes : usage.deviceBytes) += ownedSize;
+        const auto sectionFlags = m_reader->getSection(buffer.first).getHeader()->sh_flags;
+        usage.deviceBytesByProcFlags[getProcFlags(sectionFlags)] += ownedSize;
+    }
+
+    if (!includeShared) {
+        return usage;
+    }
+
+    for (const auto& buffer : m_backupBufferContainer) {
+        if (buffer.second.mBuffer) {
+            usage.backupBytes += buffer.second.mBuffer->getOwnedSize();
+        }
+    }
+
+    usage.sectionDataBytes = m_reader->getCachedDataSize();
+    return usage;
+}
+
+MemoryUsage VPUXLoader::getPeakMemoryUsage() const {
+    return m_peakMemoryUsage;
+}
+
+MemoryUsage VPUXLoader::estimateLoadMemoryUsage(bool symTabOverrideMode) const {
+    const auto numSections = m_reader->getSectionsNum();
+
+    // any relocation target is unshared by load(), including the JIT ones, and the symbol tables of the relocations
+    // applied by load() are read into the Reader cache
+    std::vector<bool> relocationTargets(numSections, false);
+    std::vector<bool> loadSymTabs(numSections, false);
+    for (size_t sectionCtr = 0; sectionCtr < numSections; ++sectionCtr) {
+        const auto sectionHeader = m_reader->getSection(sectionCtr).getHeader();
+        const auto searchAction = actionMap.find(sectionHeader->sh_type);
+        if (searchAction == actionMap.end() || searchAction->second != Action::Relocate) {
+            continue;
+        }
+        if (sectionHeader->sh_info < numSections) {
+            relocationTargets[sectionHeader->sh_info] = true;
+        }
+        if (!(sectionHeader->sh_flags & VPU_SHF_JIT) && sectionHeader->sh_link < numSections) {
+            loadSymTabs[sectionHeader->sh_link] = true;
+        }
+    }
+
+    // same classification as load()
+    MemoryUsage usage;
+    for (size_t sectionCtr = 0; sectionCtr < numSections; ++sectionCtr) {
+        const auto sectionHeader = m_reader->getSection(sectionCtr).getHeader();
+        const auto sectionFlags = sectionHeader->sh_flags;
+        const auto searchAction = actionMap.find(sectionHeader->sh_type);
+        if (searchAction == actionMap.end() || (symTabOverrideMode && !(sectionFlags & SHF_ALLOC))) {
+            continue;
+        }
+
+        if (searchAction->second == Action::AllocateAndLoad && !hasElidedProfOutputFlag(sectionCtr)) {
+            if (!(sectionFlags & SHF_WRITE) && !relocationTargets[sectionCtr]) {
+                usage.sharedDeviceBytes += sectionHeader->sh_size;
+            } else {
+                usage.deviceBytes += sectionHeader->sh_size;
+                usage.backupBytes += m_backupFreeReload ? 0 : sectionHeader->sh_size;
+            }
+        } else if (searchAction->second == Action::Allocate && !utils::isNetworkIO(sectionFlags)) {
+            usage.deviceBytes += sectionHeader->sh_size;
+        } else {
+            continue;
+        }
+        usage.deviceBytesByProcFlags[getProcFlags(sectionFlags)] += sectionHeader->sh_size;
+    }
+
+    usage.sectionDataBytes = m_reader->getCachedDataSize();
+    for (size_t sectionCtr = 0; sectionCtr < numSections; ++sectionCtr) {
+        const auto& section = m_reader->getSection(sectionCtr);
+        if (loadSymTabs[sectionCtr] && !section.getCachedDataSize()) {
+            usage.sectionDataBytes += DynamicBuffer::getAllocationSize(section.getHeader()->sh_size);
+        }
+    }
+    return usage;
+}
+
+void VPUXLoader::setMemoryBudget(const MemoryBudget& memoryBudget) {
+    m_memoryBudget = memoryBudget;
+}
+
+MemoryBudget VPUXLoader::getMemoryBudget() const {
+    return m_memoryBudget;
+}
+
+VPUXLoader::CopyBudgetChecked VPUXLoader::checkCopyMemoryBudget() const {
+    // a copy only allocates the unshared device buffers, the backups and the section data stay shared
+    MemoryUsage copyUsage;
+    copyUsage.deviceBytes = getMemoryUsage(false).deviceBytes;
+    m_memoryBudget.check(copyUsage, "copy");
+    return CopyBudgetChecked{};
+}
+
+void VPUXLoader::updatePeakMemoryUsage() {
+    m_peakMemoryUsage.updatePeak(getMemoryUsage());
+}
+
+bool VPUXLoader::hasElidedProfOutputFlag(size_t sectionIndex) const {
+    if (!m_profilingElision || sectionIndex >= m_reader->getSectionsNum()) {
+        return false;
+    }
+    return m_reader->getSection(sectionIndex).getHeader()->sh_flags & VPU_SHF_PROFOUTPUT;
+}
+
 void VPUXLoader::updateSharedScratchBuffers(const std::vector<DeviceBuffer>& buffers) {
     VPUX_ELF_THROW_WHEN(m_sharedScratchBuffers.size() != buffers.size(), RuntimeError, "Incorrect amount of buffers for updateSharedScratchBuffers");
     if (m_sharedScratchBuffers.empty()) {
         return;
     }
 
-    reloadNewBuffers();
+    // relocations were validated against the section sizes, so the buffers must be at least as large
+    for (size_t bufferIdx = 0; bufferIdx < buffers.size(); ++bufferIdx) {
+        VPUX_ELF_THROW_WHEN(buffers[bufferIdx].size() <
+                                    m_reader->getSection(m_sharedScratchBuffers[bufferIdx]).getHeader()->sh_size,
+                            ArgsError, "Shared scratch buffer smaller than its section");
+    }
+
     size_t i = 0;
     for (const auto& buffer : buffers) {
         m_inferBufferContainer.getBufferInfoFromIndex(m_sharedScratchBuffers[i++]).mBuffer->resetBuffer(buffer);
     }
 
+    auto workingSetLock =
+            ElfBufferBatchLockGuard(getWorkingSet(getReloadedSections(), *m_relocationSectionIndexes));
+    reloadNewBuffers();
+    resolveSymbolTables(*m_relocationSectionIndexes);
     applyRelocations(*m_relocationSectionIndexes);
+    updatePeakMemoryUsage();
+}
+
+void VPUXLoader::computePlacementHints() {
+    const auto numSections = m_reader->getSectionsNum();
+    m_placementHints.assign(numSections, PLACEMENT_NONE);
+
+    for (size_t sectionIdx = 0; sectionIdx < numSections; ++sectionIdx) {
+        const auto sectionHeader = m_reader->getSection(sectionIdx).getHeader();
+        // the sections the loader allocates are all device buffers
+        auto& placementHints = m_placementHints[sectionIdx];
+        placementHints |= sectionHeader->sh_flags & SHF_WRITE ? PLACEMENT_DEVICE_WRITTEN : PLACEMENT_DEVICE_READ_ONLY;
+        if (sectionHeader->sh_type == SHT_PROGBITS) {
+            placementHints |= PLACEMENT_CPU_WRITE_AT_LOAD;
+        }
+    }
+
+    for (size_t sectionIdx = 0; sectionIdx < numSections; ++sectionIdx) {
+        const auto sectionHeader = m_reader->getSection(sectionIdx).getHeader();
+        const auto isRelocation = sectionHeader->sh_type == SHT_RELA || sectionHeader->sh_type == VPU_SHT_RELA_PACKED;
+        if (isRelocation && sectionHeader->sh_info < numSections) {
+            m_placementHints[sectionHeader->sh_info] |= sectionHeader->sh_flags & VPU_SHF_JIT
+                                                                ? PLACEMENT_CPU_PATCHED_PER_INFERENCE
+                                                                : PLACEMENT_CPU_PATCHED_AT_LOAD;
+        }
+    }
+}
+
+BufferSpecs VPUXLoader::getSectionBufferSpecs(size_t sectionIndex) const {
+    const auto sectionHeader = m_reader->getSection(sectionIndex).getHeader();
+    return BufferSpecs(sectionHeader->sh_addralign, sectionHeader->sh_size, sectionHeader->sh_flags,
+                       m_placementHints.at(sectionIndex));
+}
+
+std::vector<BufferSpecs> VPUXLoader::getSharedScratchBufferSpecs() const {
+    std::vector<BufferSpecs> specs;
+    specs.reserve(m_sharedScratchBuffers.size());
+    for (auto sectionIndex : m_sharedScratchBuffers) {
+        specs.push_back(getSectionBufferSpecs(sectionIndex));
+    }
+    return specs;
+}
+
+void VPUXLoader::buildRebaseSites() {
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Build rebase sites");
+    auto rebaseSites = std::make_shared<std::map<size_t, RebaseSites>>();
+
+    // Adding the address delta is only correct if no other relocation patches the same bytes afterwards, so every
+    // patch site of a section with overlapping (or unknown size) patches is handled as a non-linear one
+    std::map<size_t /*target section index*/, PatchRanges> patches;
+    std::set<size_t /*target section index*/> overlappingTargets;
+    for (const auto& sectionPlan : m_relocationPlan->sections) {
+        auto& targetPatches = patches[sectionPlan.second.targetSectionIdx];
+        for (const auto& run : sectionPlan.second.runs) {
+            if (!run.patchSize) {
+                overlappingTargets.insert(sectionPlan.second.targetSectionIdx);
+            }
+            for (Elf_Word relocIdx = 0; relocIdx < run.count; ++relocIdx) {
+                const auto offset = run.offset + static_cast<uint64_t>(relocIdx) * run.stride;
+                targetPatches.emplace_back(offset, offset + run.patchSize);
+            }
+        }
+    }
+    for (const auto& targetPatches : patches) {
+        if (hasOverlaps(targetPatches.second)) {
+            overlappingTargets.insert(targetPatches.first);
+        }
+    }
+
+    for (const auto& relocationSectionIdx : *m_relocationSectionIndexes) {
+        const auto& sectionPlan = m_relocationPlan->sections.at(relocationSectionIdx);
+
+        // runtime symbols don't belong to any section of the ELF, so they never move
+        if (sectionPlan.symTabIdx == VPU_RT_SYMTAB) {
+            continue;
+        }
+
+        const auto symbols = m_reader->getSection(sectionPlan.symTabIdx).getData<elf::SymbolEntry>();
+        const size_t targetSectionIdx = sectionPlan.targetSectionIdx;
+
+        for (const auto& run : sectionPlan.runs) {
+            auto& sites = (*rebaseSites)[symbols[run.symIdx].st_shndx];
+            if (!isLinearRelocation(run.type) || overlappingTargets.count(targetSectionIdx)) {
+                sites.nonLinearTargets.insert(targetSectionIdx);
+                continue;
+            }
+
+            auto& linearSites = sites.linearSites[targetSectionIdx];
+            for (Elf_Word relocIdx = 0; relocIdx < run.count; ++relocIdx) {
+                linearSites.emplace_back(run.offset + static_cast<uint64_t>(relocIdx) * run.stride, run.patchSize);
+            }
+        }
+    }
+
+    m_rebaseSites = rebaseSites;
+}
+
+void VPUXLoader::moveBuffers(const std::vector<std::pair<DeviceBuffer, DeviceBuffer>>& moves) {
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Move buffers");
+    VPUX_ELF_THROW_UNLESS(m_loaded, SequenceError, "Sections were not loaded yet");
+
+    if (!m_rebaseSites) {
+        buildRebaseSites();
+    }
+
+    // every move is checked before any buffer is replaced
+    std::map<size_t /*section index*/, uint64_t /*address delta*/> addressDeltas;
+    std::vector<std::pair<AllocatedDeviceBuffer*, DeviceBuffer>> replacements;
+    for (const auto& move : moves) {
+        auto bufferIt =
+                std::find_if(m_inferBufferContainer.begin(), m_inferBufferContainer.end(), [&](const auto& elem) {
+                    return elem.second.mBuffer->getBuffer().vpu_addr() == move.first.vpu_addr();
+                });
+        VPUX_ELF_THROW_WHEN(bufferIt == m_inferBufferContainer.end(), ArgsError,
+                            "Buffer to move was not allocated by the loader");
+
+        auto& bufferInfo = bufferIt->second;
+        VPUX_ELF_THROW_WHEN(bufferInfo.mBufferDetails.mIsShared, ArgsError, "Shared buffers can't be moved");
+        auto allocatedBuffer = dynamic_cast<AllocatedDeviceBuffer*>(bufferInfo.mBuffer.get());
+        VPUX_ELF_THROW_UNLESS(allocatedBuffer, ArgsError, "Buffers sub-allocated from an arena can't be moved");
+        VPUX_ELF_THROW_UNLESS(move.second.size() == bufferInfo.mBuffer->getBuffer().size(), ArgsError,
+                              "Size mismatch between moved buffer and its new location");
+
+        VPUX_ELF_THROW_UNLESS(
+                addressDeltas.emplace(bufferIt->first, move.second.vpu_addr() - move.first.vpu_addr()).second,
+                ArgsError, "Buffer moved more than once");
+        replacements.emplace_back(allocatedBuffer, move.second);
+    }
+
+    for (const auto& replacement : replacements) {
+        replacement.first->replaceAllocation(replacement.second);
+    }
+
+    resolveSymbolTables(*m_relocationSectionIndexes);
+
+    // Sections with non-linear patch sites referencing a moved section are restored and relocated from scratch
+    std::set<size_t> restoredSections;
+    for (const auto& addressDelta : addressDeltas) {
+        auto sites = m_rebaseSites->find(addressDelta.first);
+        if (sites != m_rebaseSites->end()) {
+            restoredSections.insert(sites->second.nonLinearTargets.begin(), sites->second.nonLinearTargets.end());
+        }
+    }
+
+    if (!restoredSections.empty()) {
+        auto isRestoredTarget = [&](size_t relocationSectionIdx) {
+            return restoredSections.count(m_reader->getSection(relocationSectionIdx).getHeader()->sh_info) != 0;
+        };
+
+        std::vector<std::size_t> relocationSectionIndexes;
+        std::copy_if(m_relocationSectionIndexes->begin(), m_relocationSectionIndexes->end(),
+                     std::back_inserter(relocationSectionIndexes), isRestoredTarget);
+        std::vector<std::size_t> jitRelocationSectionIndexes;
+        std::copy_if(m_jitRelocations->begin(), m_jitRelocations->end(),
+                     std::back_inserter(jitRelocationSectionIndexes), isRestoredTarget);
+
+        for (const auto& sectionIdx : restoredSections) {
+            VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tRestoring section %zu", sectionIdx);
+        }
+        reloadBuffers(std::vector<size_t>(restoredSections.begin(), restoredSections.end()));
+
+        applyRelocations(relocationSectionIndexes);
+        if (m_jitRelocationsApplied) {
+            applyJitRelocations(jitRelocationSectionIndexes, m_jitInputs, m_jitOutputs, m_jitProfiling);
+        }
+    }
+
+    // Every other patch site referencing a moved section only needs the address delta
+    std::vector<ManagedBuffer*> rebasedBuffers;
+    for (const auto& addressDelta : addressDeltas) {
+        auto sites = m_rebaseSites->find(addressDelta.first);
+        if (sites == m_rebaseSites->end()) {
+            continue;
+        }
+
+        for (const auto& targetSites : sites->second.linearSites) {
+            if (!restoredSections.count(targetSites.first)) {
+                rebasedBuffers.push_back(
+                        m_inferBufferContainer.getBufferInfoFromIndex(targetSites.first).mBuffer.get());
+            }
+        }
+    }
+
+    auto rebasedBuffersLock = ElfBufferBatchLockGuard(rebasedBuffers);
+    for (const auto& addressDelta : addressDeltas) {
+        auto sites = m_rebaseSites->find(addressDelta.first);
+        if (sites == m_rebaseSites->end()) {
+            continue;
+        }
+
+        for (const auto& targetSites : sites->second.linearSites) {
+            if (restoredSections.count(targetSites.first)) {
+                continue;
+            }
+
+            auto& targetSectionBuf = m_inferBufferContainer.getBufferInfoFromIndex(targetSites.first).mBuffer;
+            auto targetSectionAddr = targetSectionBuf->getBuffer().cpu_addr();
+
+            VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tRebasing %zu sites of section %zu by 0x%llx",
+                         targetSites.second.size(), targetSites.first, addressDelta.second);
+            for (const auto& site : targetSites.second) {
+                addAddressDelta(targetSectionAddr + site.first, site.second, addressDelta.second);
+            }
+        }
+    }
+}
+
+namespace {
+
+bool overlaps(PatchRanges lhs, PatchRanges rhs) {
+    std::sort(lhs.begin(), lhs.end());
+    std::sort(rhs.begin(), rhs.end());
+
+    auto lhsIt = lhs.begin();
+    auto rhsIt = rhs.begin();
+    while (lhsIt != lhs.end() && rhsIt != rhs.end()) {
+        if (lhsIt->first < rhsIt->second && rhsIt->first < lhsIt->second) {
+            return true;
+        }
+        if (lhsIt->second <= rhsIt->second) {
+            ++lhsIt;
+        } else {
+            ++rhsIt;
+        }
+    }
+    return false;
+}
+
+size_t appendAligned(std::vector<uint8_t>& elfBlob, const void* data, size_t size, size_t alignment) {
+    elfBlob.resize(utils::alignUp(elfBlob.size(), alignment));
+    const auto offset = elfBlob.size();
+    elfBlob.insert(elfBlob.end(), reinterpret_cast<const uint8_t*>(data),
+                   reinterpret_cast<const uint8_t*>(data) + size);
+    return offset;
+}
+
+}  // namespace
+
+std::vector<uint8_t> VPUXLoader::foldRuntimeSymTabRelocations(const uint8_t* elfBlob, size_t elfSize,
+                                                              const std::vector<SymbolEntry>& runtimeSymTabs,
+                                                              elf::platform::ArchKind archKind, uint8_t tileCount) {
+    VPUX_ELF_LOG(LogLevel::LOG_TRACE, "Fold runtime symtab relocations");
+    VPUX_ELF_THROW_UNLESS(elfBlob && elfSize >= sizeof(ELFHeader), ArgsError, "Invalid ELF blob");
+
+    std::vector<uint8_t> folded(elfBlob, elfBlob + elfSize);
+
+    ELFHeader elfHeader{};
+    memcpy(&elfHeader, folded.data(), sizeof(elfHeader));
+    VPUX_ELF_THROW_UNLESS(utils::checkELFMagic(elfHeader.e_ident), HeaderError, "Incorrect ELF magic");
+    VPUX_ELF_THROW_UNLESS(elfHeader.e_shentsize == sizeof(SectionHeader), HeaderError,
+                          "Size of section header doesn't match with the elf's bitness");
+    VPUX_ELF_THROW_UNLESS(elfHeader.e_shoff >= sizeof(elfHeader) && elfHeader.e_shoff <= elfSize &&
+                                  elfHeader.e_shnum <= (elfSize - elfHeader.e_shoff) / sizeof(SectionHeader),
+                          HeaderError, "Section headers outside of the ELF blob");
+
+    std::vector<SectionHeader> sectionHeaders(elfHeader.e_shnum);
+    memcpy(sectionHeaders.data(), folded.data() + elfHeader.e_shoff, sectionHeaders.size() * sizeof(SectionHeader));
+
+    auto getSectionData = [&](const SectionHeader& header) -> uint8_t* {
+        VPUX_ELF_THROW_WHEN(header.sh_offset > elfSize || header.sh_size > elfSize - header.sh_offset, SectionError,
+                            "Section data outside of the ELF blob");
+        return folded.data() + header.sh_offset;
+    };
+
+    auto getEntriesNum = [](const SectionHeader& header) -> size_t {
+        VPUX_ELF_THROW_UNLESS(header.sh_entsize, SectionError, "Relocation section with sh_entsize=0");
+        return static_cast<size_t>(header.sh_size / header.sh_entsize);
+    };
+
+    // Relocation sections are applied by the loader in section index order, with the JIT ones last. Folding moves a
+    // section ahead of all the sections left in the ELF, which is safe only if none of the preceding unfolded
+    // sections patches the same bytes of the target section
+    std::map<Elf_Word /*target section index*/, PatchRanges> unfoldedPatches;
+    std::map<Elf_Word /*target section index*/, bool> hasUnknownPatches;
+    uint32_t foldedCount = 0;
+
+    for (size_t sectionIdx = 0; sectionIdx < sectionHeaders.size(); ++sectionIdx) {
+        auto& relocSecHdr = sectionHeaders[sectionIdx];
+        const bool isRelocation = relocSecHdr.sh_type == SHT_RELA || relocSecHdr.sh_type == VPU_SHT_RELA_PACKED;
+        if (!isRelocation || (relocSecHdr.sh_flags & VPU_SHF_JIT)) {
+            continue;
+        }
+
+        VPUX_ELF_THROW_UNLESS(relocSecHdr.sh_flags & SHF_INFO_LINK, RelocError, "Rela section with no target section");
+        const auto targetSectionIdx = relocSecHdr.sh_info;
+        VPUX_ELF_THROW_WHEN(targetSectionIdx == 0 || targetSectionIdx >= sectionHeaders.size(), RelocError,
+                            "invalid target section from rela section");
+
+        const auto relocations = getSectionData(relocSecHdr);
+        const auto numEntries = getEntriesNum(relocSecHdr);
+
+        PatchRanges patches;
+        const bool isKnown = collectPatchRanges(relocSecHdr.sh_type, relocations, numEntries, patches);
+
+        const auto& targetSecHdr = sectionHeaders[targetSectionIdx];
+        const bool isFoldable = relocSecHdr.sh_link == VPU_RT_SYMTAB && isKnown &&
+                                utils::hasMemoryFootprint(targetSecHdr.sh_type) &&
+                                !hasUnknownPatches[targetSectionIdx] &&
+                                !overlaps(patches, unfoldedPatches[targetSectionIdx]);
+
+        if (!isFoldable) {
+            auto& targetPatches = unfoldedPatches[targetSectionIdx];
+            targetPatches.insert(targetPatches.end(), patches.begin(), patches.end());
+            hasUnknownPatches[targetSectionIdx] = hasUnknownPatches[targetSectionIdx] || !isKnown;
+            continue;
+        }
+
+        const auto targetSectionAddr = getSectionData(targetSecHdr);
+        const auto targetSectionSize = targetSecHdr.sh_size;
+        forEachRelocationRun(relocSecHdr.sh_type, relocations, numEntries, [&](const VPU_PackedRelocationAEntry& run) {
+            const auto relType = elf64RType(run.r_info);
+            const auto relSymIdx = elf64RSym(run.r_info);
+
+            VPUX_ELF_THROW_UNLESS(
+                    isRelocationRunInBounds(run, utils::getRelocationPatchSize(relType), targetSectionSize),
+                    RelocError, "RelocOffset outside of the section size");
+            VPUX_ELF_THROW_WHEN(relSymIdx >= runtimeSymTabs.size(), RelocError, "SymTab index out of bounds!");
+
+            auto reloc = relocationMap.find(static_cast<RelocationType>(relType));
+            VPUX_ELF_THROW_WHEN(reloc == relocationMap.end() || reloc->second == nullptr, RelocError,
+                                "Invalid relocation type detected");
+
+            const auto& relocFunc = reloc->second;
+            auto relOffset = run.r_offset;
+            auto addend = run.r_addend;
+            for (Elf_Word relocIdx = 0; relocIdx < run.r_count; ++relocIdx) {
+                relocFunc((void*)(targetSectionAddr + relOffset), runtimeSymTabs[relSymIdx], addend);
+
+                relOffset += run.r_stride;
+                addend = static_cast<Elf_Sxword>(static_cast<uint64_t>(addend) +
+                                                 static_cast<uint64_t>(run.r_addend_stride));
+            }
+        });
+
+        VPUX_ELF_LOG(LogLevel::LOG_DEBUG, "\tFolded %zu relocations of section %zu into section %u", patches.size(),
+                     sectionIdx, targetSectionIdx);
+
+        foldedCount += static_cast<uint32_t>(patches.size());
+        relocSecHdr.sh_type = SHT_NULL;
+    }
+
+    if (!foldedCount) {
+        VPUX_ELF_LOG(LogLevel::LOG_INFO, "No runtime symtab relocation could be folded");
+        return folded;
+    }
+
+    elf_note::VersionNote foldingNote{};
+    foldingNote.n_namesz = sizeof(foldingNote.n_name);
+    foldingNote.n_descz = sizeof(foldingNote.n_desc);
+    foldingNote.n_type = elf_note::NT_NPU_RT_SYMTAB_FOLDED;
+    memcpy(foldingNote.n_name, "NPU", sizeof(foldingNote.n_name));
+    foldingNote.n_desc[0] = static_cast<uint32_t>(archKind);
+    foldingNote.n_desc[1] = tileCount;
+    foldingNote.n_desc[2] = foldedCount;
+
+    SectionHeader noteSecHdr{};
+    noteSecHdr.sh_type = SHT_NOTE;
+    noteSecHdr.sh_addralign = alignof(elf_note::VersionNote);
+    noteSecHdr.sh_size = sizeof(foldingNote);
+    noteSecHdr.sh_offset = appendAligned(folded, &foldingNote, sizeof(foldingNote), noteSecHdr.sh_addralign);
+
+    // the name of the note goes to a copy of the section names string table appended to the blob
+    if (elfHeader.e_shstrndx != SHN_UNDEF && elfHeader.e_shstrndx < sectionHeaders.size()) {
+        auto& strTabHdr = sectionHeaders[elfHeader.e_shstrndx];
+        const auto strTabData = getSectionData(strTabHdr);
+        std::vector<uint8_t> strTab(strTabData, strTabData + strTabHdr.sh_size);
+
+        const char noteName[] = ".note.NPU.rt_symtab_folded";
+        noteSecHdr.sh_name = static_cast<Elf_Word>(strTab.size());
+        strTab.insert(strTab.end(), noteName, noteName + sizeof(noteName));
+
+        strTabHdr.sh_offset = appendAligned(folded, strTab.data(), strTab.size(), 1);
+        strTabHdr.sh_size = strTab.size();
+    }
+
+    sectionHeaders.push_back(noteSecHdr);
+    VPUX_ELF_THROW_WHEN(sectionHeaders.size() >= SHN_LORESERVE, RangeError, "Too many sections");
+
+    elfHeader.e_shoff = appendAligned(folded, sectionHeaders.data(), sectionHeaders.size() * sizeof(SectionHeader),
+                                      alignof(SectionHeader));
+    elfHeader.e_shnum = static_cast<Elf_Half>(sectionHeaders.size());
+    memcpy(folded.data(), &elfHeader, sizeof(elfHeader));
+
+    VPUX_ELF_LOG(LogLevel::LOG_INFO, "Folded %u runtime symtab relocations", foldedCount);
+
+    return folded;
 }
 
 }  // namespace elf
@@ -0,0 +1,178 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// Storage of the loader buffers: the sections container, and the sections sub-allocated from arenas or from the
+// PT_LOAD segments of the blob, which must be patched as when they get an allocation each
+
+#include "../common/test_utils.hpp"
+
+#include <vpux_elf/utils/error.hpp>
+#include <vpux_headers/device_buffer_container.hpp>
+
+#include <algorithm>
+#include <string>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+struct LoadResult {
+    TestBufferManager::Calls calls;
+    std::vector<uint64_t> allocatedSizes;
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> weights;
+    bool patchSitesPassed = false;
+};
+
+enum class AllocationMode { PER_SECTION, ARENA, SEGMENT };
+
+// With shareScratch, the scratch sections are shared by the driver, so they are left out of the arenas
+LoadResult loadBlob(const std::vector<uint8_t>& blob, AllocationMode mode, bool shareScratch) {
+    TestBufferManager bufferManager(shareScratch);
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    loader.setInferencesMayBeRunInParallel(!shareScratch);
+    loader.setArenaAllocations(mode == AllocationMode::ARENA);
+    loader.setSegmentAllocations(mode == AllocationMode::SEGMENT);
+    loader.load(getTestRuntimeSymbols());
+
+    std::vector<DeviceBuffer> scratchBuffers;
+    for (const auto& specs : loader.getSharedScratchBufferSpecs()) {
+        scratchBuffers.push_back(bufferManager.allocate(BufferSpecs(specs.alignment, specs.size, 0)));
+    }
+    loader.updateSharedScratchBuffers(scratchBuffers);
+    TestIO io;
+    loader.applyJitRelocations(io.inputs, io.outputs, io.profiling);
+
+    LoadResult result;
+    result.patchSitesPassed = checkPatchSites(loader, io);
+    const auto data = findBuffer(loader, DATA_SIZE);
+    result.data.assign(data.cpu_addr(), data.cpu_addr() + data.size());
+    const auto weights = findBuffer(loader, WEIGHTS_SIZE);
+    result.weights.assign(weights.cpu_addr(), weights.cpu_addr() + weights.size());
+
+    for (auto& scratchBuffer : scratchBuffers) {
+        bufferManager.deallocate(scratchBuffer);
+    }
+    result.calls = bufferManager.getCalls();
+    result.allocatedSizes = bufferManager.getAllocatedSizes();
+    return result;
+}
+
+bool testDenseContainer() {
+    TestBufferManager bufferManager;
+    DeviceBufferContainer container(&bufferManager);
+    container.safeInitBufferInfoAtIndex(7).mBuffer = container.buildAllocatedDeviceBuffer(BufferSpecs(64, 128, 0));
+    container.safeInitBufferInfoAtIndex(2).mBuffer = container.buildAllocatedDeviceBuffer(BufferSpecs(64, 256, 0));
+
+    bool passed = check(container.getBufferInfoCount() == 2, "wrong number of buffers");
+    passed &= check(!container.hasBufferInfoAtIndex(3) && !container.hasBufferInfoAtIndex(100),
+                    "absent slots are reported present");
+
+    std::vector<size_t> indexes;
+    for (const auto& slot : container) {
+        indexes.push_back(slot.first);
+    }
+    passed &= check(indexes == std::vector<size_t>{2, 7}, "slots are not iterated in section index order");
+
+    bool throws = false;
+    try {
+        container.safeInitBufferInfoAtIndex(7);
+    } catch (const RuntimeError&) {
+        throws = true;
+    }
+    passed &= check(throws, "a slot was initialized twice");
+
+    // a copy gets buffers of its own
+    {
+        DeviceBufferContainer copy(container);
+        passed &= check(copy.getBufferInfoCount() == 2 && copy.hasBufferInfoAtIndex(7), "the copy lost slots");
+        passed &= check(copy.getBufferInfoFromIndex(7).mBuffer->getBuffer().vpu_addr() !=
+                                container.getBufferInfoFromIndex(7).mBuffer->getBuffer().vpu_addr(),
+                        "the copy shares the buffers of the original");
+    }
+    passed &= check(bufferManager.getLiveBuffersCount() == 2, "the copy didn't release its buffers");
+    return passed;
+}
+
+bool testArena() {
+    const auto blob = buildTestBlob({});
+    const auto perSection = loadBlob(blob, AllocationMode::PER_SECTION, false);
+    const auto arena = loadBlob(blob, AllocationMode::ARENA, false);
+
+    bool passed = check(perSection.patchSitesPassed && arena.patchSitesPassed, "wrong patch sites");
+    // .scratch and .bss share an arena
+    passed &= check(arena.calls.allocate < perSection.calls.allocate, "arena mode doesn't save allocations");
+    passed &= check(arena.data == perSection.data && arena.weights == perSection.weights,
+                    "arena mode changes the bytes of the sections");
+    passed &= check(arena.calls.violations == 0, "the loader broke the BufferManager contract");
+    return passed;
+}
+
+bool testSegment() {
+    const auto blob = buildTestBlob({/*packing=*/true, /*loadSegments=*/true});
+
+    // the writable sections without relocations have the same flags, the writer puts them in the same segment, after
+    // .data
+    {
+        DDRAccessManager<DDRAlwaysEmplace> accessor(blob.data(), blob.size());
+        Reader<ELF_Bitness::Elf64> reader(&accessor);
+        std::vector<uint64_t> addresses;
+        for (size_t sectionIdx = 0; sectionIdx < reader.getSectionsNum(); ++sectionIdx) {
+            const auto section = reader.getSection(sectionIdx);
+            const std::string name = section.getName();
+            if (name == ".data" || name == ".scratch" || name == ".bss") {
+                addresses.push_back(section.getHeader()->sh_addr);
+            }
+        }
+
+        bool isShared = false;
+        for (size_t segmentIdx = 0; segmentIdx < reader.getSegmentsNum(); ++segmentIdx) {
+            const auto segment = reader.getSegment(segmentIdx);
+            isShared |= segment->p_type == PT_LOAD &&
+                        std::all_of(addresses.begin(), addresses.end(), [&](uint64_t address) {
+                            return address >= segment->p_vaddr && address - segment->p_vaddr < segment->p_memsz;
+                        });
+        }
+        if (!check(addresses.size() == 3 && isShared, ".data, .scratch and .bss are not in the same segment")) {
+            return false;
+        }
+    }
+
+    // .weights is uploaded with the file bytes of its segment
+    const auto perSection = loadBlob(blob, AllocationMode::PER_SECTION, false);
+    const auto segment = loadBlob(blob, AllocationMode::SEGMENT, false);
+    bool passed = check(perSection.patchSitesPassed && segment.patchSitesPassed, "wrong patch sites");
+    passed &= check(segment.data == perSection.data && segment.weights == perSection.weights,
+                    "segment mode changes the bytes of the sections");
+    passed &= check(segment.calls.violations == 0, "the loader broke the BufferManager contract");
+
+    // the shared scratch sections keep their own buffers, the arena of their segment only spans .data instead of
+    // the whole segment
+    const auto sharedScratch = loadBlob(blob, AllocationMode::SEGMENT, true);
+    const std::vector<uint64_t> sectionSizes = {DMA_SIZE, WEIGHTS_SIZE, MI_SIZE, DATA_SIZE, SCRATCH_SIZE, BSS_SIZE};
+    passed &= check(sharedScratch.patchSitesPassed, "wrong patch sites with shared scratch sections");
+    passed &= check(sharedScratch.data == perSection.data, "segment mode changes the bytes of .data");
+    passed &= check(std::all_of(sharedScratch.allocatedSizes.begin(), sharedScratch.allocatedSizes.end(),
+                                [&](uint64_t size) {
+                                    return std::count(sectionSizes.begin(), sectionSizes.end(), size) != 0;
+                                }),
+                    "the arena of a segment is not sized from its placed sections");
+    passed &= check(sharedScratch.calls.violations == 0, "the loader broke the BufferManager contract");
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"dense container", testDenseContainer},
+            {"arena", testArena},
+            {"segment", testSegment},
+    });
+}
@@ -0,0 +1,151 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// CachingBufferManager must hand the deallocated buffers out again, and pass the buffers it doesn't cache through to
+// the underlying manager
+
+#include "../common/test_utils.hpp"
+
+#include <vpux_headers/caching_buffer_manager.hpp>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+bool testSizeClasses() {
+    bool passed = check(CachingBufferManager::getSizeClass(1) == CachingBufferManager::MIN_SIZE_CLASS &&
+                                CachingBufferManager::getSizeClass(4096) == 4096,
+                        "small sizes are not rounded to the minimum size class");
+    passed &= check(CachingBufferManager::getSizeClass(4097) == 5120 &&
+                            CachingBufferManager::getSizeClass(5000) == 5120 &&
+                            CachingBufferManager::getSizeClass(7169) == 8192,
+                    "wrong size classes");
+    passed &= check(CachingBufferManager::getSizeClass(16384) == 16384, "powers of two are not size classes");
+    return passed;
+}
+
+bool testRecycling() {
+    const auto blob = buildTestBlob({});
+    TestBufferManager underlyingManager;
+    bool passed = true;
+    {
+        CachingBufferManager cachingManager(&underlyingManager);
+        TestIO io;
+        size_t firstLoadAllocations = 0;
+        for (size_t loadIdx = 0; loadIdx < 2; ++loadIdx) {
+            auto accessor = makeAccessManager(blob, &cachingManager);
+            VPUXLoader loader(accessor.get(), &cachingManager);
+            loadAndApplyIO(loader, io);
+            passed &= checkPatchSites(loader, io);
+
+            if (!loadIdx) {
+                firstLoadAllocations = underlyingManager.getCalls().allocate;
+            }
+        }
+
+        // the second load only got recycled buffers
+        const auto stats = cachingManager.getCacheStats();
+        passed &= check(underlyingManager.getCalls().allocate == firstLoadAllocations,
+                        "the second load reached the underlying manager");
+        passed &= check(stats.hits == stats.misses && stats.hits != 0, "the second load missed the cache");
+        passed &= check(stats.cachedBuffers == firstLoadAllocations, "the buffers of the loads were not cached");
+        passed &= check(underlyingManager.getLiveBuffersCount() == stats.cachedBuffers,
+                        "the cached buffers were released");
+    }
+    passed &= check(underlyingManager.getLiveBuffersCount() == 0, "the cached buffers were not released");
+    passed &= check(underlyingManager.getCalls().violations == 0, "the cache broke the BufferManager contract");
+    return passed;
+}
+
+bool testRequestedSize() {
+    TestBufferManager underlyingManager;
+    CachingBufferManager cachingManager(&underlyingManager);
+
+    auto buffer = cachingManager.allocate(BufferSpecs(64, 4500, 0));
+    bool passed = check(buffer.size() == 4500, "the buffer doesn't keep the requested size");
+    passed &= check(underlyingManager.getAllocatedSizes().back() == 5120, "the allocation is not of the size class");
+
+    // a request of the same size class gets the same allocation
+    const auto vpuAddress = buffer.vpu_addr();
+    cachingManager.deallocate(buffer);
+    auto recycled = cachingManager.allocate(BufferSpecs(64, 5000, 0));
+    passed &= check(recycled.vpu_addr() == vpuAddress && recycled.size() == 5000, "the allocation was not recycled");
+
+    // the lock and copy calls reach the underlying manager with the full allocation
+    const std::vector<uint8_t> data(5000, 0x11);
+    cachingManager.lock(recycled);
+    cachingManager.copy(recycled, data.data(), data.size());
+    cachingManager.unlock(recycled);
+    passed &= check(underlyingManager.getCalls().violations == 0, "the forwarded calls broke the contract");
+
+    cachingManager.deallocate(recycled);
+    return passed;
+}
+
+bool testTrim() {
+    TestBufferManager underlyingManager;
+    CachingBufferManager cachingManager(&underlyingManager, 3 * 4096);
+
+    std::vector<DeviceBuffer> buffers;
+    for (size_t bufferIdx = 0; bufferIdx < 4; ++bufferIdx) {
+        buffers.push_back(cachingManager.allocate(BufferSpecs(64, 4096, 0)));
+    }
+    const auto first = buffers.front();
+    const auto last = buffers.back();
+    for (auto& buffer : buffers) {
+        cachingManager.deallocate(buffer);
+    }
+
+    // the first deallocated buffer doesn't fit under the cap
+    auto stats = cachingManager.getCacheStats();
+    bool passed = check(stats.cachedBuffers == 3 && stats.cachedSize == 3 * 4096 && stats.trimmedBuffers == 1,
+                        "the cache exceeds its cap");
+    passed &= check(!underlyingManager.isLive(first) && underlyingManager.isLive(last),
+                    "the least recently deallocated buffer was not trimmed first");
+
+    cachingManager.trim();
+    stats = cachingManager.getCacheStats();
+    passed &= check(stats.cachedBuffers == 0 && underlyingManager.getLiveBuffersCount() == 0, "trim left buffers");
+    return passed;
+}
+
+bool testPassThrough() {
+    TestBufferManager underlyingManager(/*shareScratch=*/true);
+    CachingBufferManager cachingManager(&underlyingManager);
+
+    // sharable buffers and empty allocations are not cached
+    auto sharable = cachingManager.allocate(BufferSpecs(64, 4096, SHARABLE_BUFFER_ENABLED));
+    bool passed = check(!sharable.vpu_addr() && underlyingManager.getCalls().allocate == 1,
+                        "a sharable buffer was not passed through");
+    cachingManager.deallocate(sharable);
+    passed &= check(underlyingManager.getCalls().deallocate == 1 && cachingManager.getCacheStats().cachedBuffers == 0,
+                    "an empty allocation was cached");
+
+    // as are the buffers the cache didn't allocate, e.g. the shared scratch buffers
+    auto foreign = underlyingManager.allocate(BufferSpecs(64, 4096, 0));
+    const auto foreignCopy = foreign;
+    cachingManager.lock(foreign);
+    cachingManager.unlock(foreign);
+    cachingManager.deallocate(foreign);
+    passed &= check(!underlyingManager.isLive(foreignCopy) && cachingManager.getCacheStats().cachedBuffers == 0,
+                    "a buffer not allocated by the cache was not passed through");
+    passed &= check(underlyingManager.getCalls().violations == 0, "the cache broke the BufferManager contract");
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"size classes", testSizeClasses},
+            {"recycling", testRecycling},
+            {"requested size", testRequestedSize},
+            {"trim", testTrim},
+            {"pass through", testPassThrough},
+    });
+}
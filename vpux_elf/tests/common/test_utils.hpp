@@ -0,0 +1,695 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// Helpers shared by the loader tests: a BufferManager simulating the device memory in host memory, the blob the tests
+// load and the checks of the bytes patched by the loader
+
+#pragma once
+
+#include <vpux_elf/accessor.hpp>
+#include <vpux_elf/reader.hpp>
+#include <vpux_elf/utils/version.hpp>
+#include <vpux_elf/writer.hpp>
+#include <vpux_headers/host_allocator.hpp>
+#include <vpux_headers/platform.hpp>
+#include <vpux_headers/serial_metadata.hpp>
+#include <vpux_loader/vpux_loader.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace elf {
+namespace test {
+
+/**
+ * Device memory simulated in host memory. Addresses are handed out by a bump allocator, so that the same allocation
+ * sequence gets the same addresses and the buffers of two loads can be compared byte for byte.
+ *
+ * Calls are counted and the lock contract of BufferManager is checked (a buffer is locked at most once at a time, only
+ * live buffers are locked, copied to or deallocated), violations are counted. Sharable buffers get an empty allocation
+ * when shareScratch is set, like a driver sharing the scratch buffers. Calls may come from several threads.
+ */
+class TestBufferManager : public BufferManager {
+public:
+    struct Calls {
+        size_t allocate = 0;
+        size_t deallocate = 0;
+        size_t lock = 0;
+        size_t unlock = 0;
+        size_t lockMany = 0;
+        size_t unlockMany = 0;
+        size_t copy = 0;
+        size_t copyv = 0;
+        size_t copyAt = 0;
+        size_t violations = 0;
+    };
+
+    explicit TestBufferManager(bool shareScratch = false): mShareScratch(shareScratch) {
+    }
+
+    DeviceBuffer allocate(const BufferSpecs& specs) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mCalls.allocate;
+        if (mShareScratch && specs.isSharable()) {
+            return DeviceBuffer();
+        }
+
+        const auto alignment = std::max<uint64_t>(specs.alignment, 1);
+        mNextAddress = (mNextAddress + alignment - 1) / alignment * alignment;
+        auto& allocation = mAllocations[mNextAddress];
+        allocation.storage.assign(std::max<uint64_t>(specs.size, 1), 0xCD);
+        mAllocatedSizes.push_back(specs.size);
+
+        DeviceBuffer buffer(allocation.storage.data(), mNextAddress, specs.size);
+        mNextAddress += std::max<uint64_t>(specs.size, 1);
+        return buffer;
+    }
+
+    void deallocate(DeviceBuffer& buffer) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mCalls.deallocate;
+        if (!buffer.vpu_addr()) {
+            return;
+        }
+        auto allocation = mAllocations.find(buffer.vpu_addr());
+        if (allocation == mAllocations.end() || allocation->second.locked) {
+            ++mCalls.violations;
+            return;
+        }
+        mAllocations.erase(allocation);
+    }
+
+    void lock(DeviceBuffer& buffer) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mCalls.lock;
+        lockLocked(buffer);
+    }
+
+    void unlock(DeviceBuffer& buffer) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mCalls.unlock;
+        unlockLocked(buffer);
+    }
+
+    void lockMany(const std::vector<DeviceBuffer*>& buffers) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mCalls.lockMany;
+        for (auto buffer : buffers) {
+            lockLocked(*buffer);
+        }
+    }
+
+    void unlockMany(const std::vector<DeviceBuffer*>& buffers) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mCalls.unlockMany;
+        for (auto buffer : buffers) {
+            unlockLocked(*buffer);
+        }
+    }
+
+    size_t copy(DeviceBuffer& to, const uint8_t* from, size_t count) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mCalls.copy;
+        return copyLocked(to, 0, from, count);
+    }
+
+    size_t copyv(const std::vector<BufferCopy>& copies) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mCalls.copyv;
+        size_t copied = 0;
+        for (const auto& bufferCopy : copies) {
+            copied += copyLocked(*bufferCopy.to, bufferCopy.offset, bufferCopy.from, bufferCopy.count);
+        }
+        return copied;
+    }
+
+    size_t copyAt(DeviceBuffer& to, size_t offset, const uint8_t* from, size_t count) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mCalls.copyAt;
+        return copyLocked(to, offset, from, count);
+    }
+
+    Calls getCalls() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mCalls;
+    }
+
+    size_t getLiveBuffersCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mAllocations.size();
+    }
+
+    bool isLive(const DeviceBuffer& buffer) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mAllocations.find(buffer.vpu_addr()) != mAllocations.end();
+    }
+
+    bool isLocked(const DeviceBuffer& buffer) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const auto allocation = mAllocations.find(buffer.vpu_addr());
+        return allocation != mAllocations.end() && allocation->second.locked;
+    }
+
+    // sizes requested by the allocate calls, in order
+    std::vector<uint64_t> getAllocatedSizes() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mAllocatedSizes;
+    }
+
+private:
+    struct Allocation {
+        std::vector<uint8_t> storage;
+        bool locked = false;
+    };
+
+    Allocation* findLocked(const DeviceBuffer& buffer) {
+        auto allocation = mAllocations.find(buffer.vpu_addr());
+        return allocation != mAllocations.end() ? &allocation->second : nullptr;
+    }
+
+    void lockLocked(DeviceBuffer& buffer) {
+        auto allocation = findLocked(buffer);
+        if (!allocation || allocation->locked) {
+            ++mCalls.violations;
+            return;
+        }
+        allocation->locked = true;
+    }
+
+    void unlockLocked(DeviceBuffer& buffer) {
+        auto allocation = findLocked(buffer);
+        if (!allocation || !allocation->locked) {
+            ++mCalls.violations;
+            return;
+        }
+        allocation->locked = false;
+    }
+
+    size_t copyLocked(DeviceBuffer& to, size_t offset, const uint8_t* from, size_t count) {
+        auto allocation = findLocked(to);
+        if (!allocation || offset > to.size() || count > to.size() - offset) {
+            ++mCalls.violations;
+            return 0;
+        }
+        std::memcpy(allocation->storage.data() + offset, from, count);
+        return count;
+    }
+
+    bool mShareScratch;
+    mutable std::mutex mMutex;
+    uint64_t mNextAddress = 0x20000000;
+    std::map<uint64_t, Allocation> mAllocations;
+    std::vector<uint64_t> mAllocatedSizes;
+    Calls mCalls;
+};
+
+/**
+ * Host allocator backed by aligned operator new, recording the sizes it is asked for and the allocations still live.
+ * Calls may come from several threads.
+ */
+class RecordingHostAllocator {
+public:
+    RecordingHostAllocator()
+            : mAllocator(std::make_shared<CallbackHostAllocator>(
+                      [this](size_t size, size_t alignment) {
+                          auto ptr = ::operator new(size, std::align_val_t(alignment));
+                          std::lock_guard<std::mutex> lock(mMutex);
+                          mSizes.push_back(size);
+                          mAlignments[ptr] = alignment;
+                          return ptr;
+                      },
+                      [this](void* ptr, size_t) {
+                          std::lock_guard<std::mutex> lock(mMutex);
+                          ::operator delete(ptr, std::align_val_t(mAlignments.at(ptr)));
+                          mAlignments.erase(ptr);
+                      })) {
+    }
+
+    const std::shared_ptr<HostAllocator>& getAllocator() const {
+        return mAllocator;
+    }
+
+    bool hasAllocated(size_t size) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return std::find(mSizes.begin(), mSizes.end(), size) != mSizes.end();
+    }
+
+    size_t getAllocationsCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mSizes.size();
+    }
+
+    size_t getLiveAllocationsCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mAlignments.size();
+    }
+
+private:
+    mutable std::mutex mMutex;
+    std::vector<size_t> mSizes;
+    std::map<void*, size_t> mAlignments;
+    std::shared_ptr<HostAllocator> mAllocator;
+};
+
+// Sizes of the sections of the test blob, unique so that the buffers of the loader can be told apart by size
+constexpr size_t DMA_SIZE = 16 * 1024;
+constexpr size_t WEIGHTS_SIZE = 3000;
+constexpr size_t MI_SIZE = 512;
+constexpr size_t DATA_SIZE = 320;
+constexpr size_t SCRATCH_SIZE = 4096;
+constexpr size_t BSS_SIZE = 640;
+constexpr size_t PROFILING_SIZE = 2048;
+constexpr size_t INPUT_SIZE = 1024;
+constexpr size_t PROFILING_OUTPUT_SIZE = 768;
+constexpr size_t OUTPUT_SIZE = 1536;
+
+// Patch sites of the test blob inside .text.mi
+constexpr size_t MI_SITES_COUNT = 32;
+constexpr size_t MI_RUNTIME_SITES_OFFSET = 256;
+constexpr size_t MI_RUNTIME_SITES_COUNT = 8;
+constexpr size_t MI_PROFILING_SITE_OFFSET = 320;
+constexpr size_t MI_PROFILING_OUTPUT_SITES_OFFSET = 384;
+constexpr size_t MI_PROFILING_OUTPUT_SITES_COUNT = 4;
+// Patch sites of the test blob inside .text.dma
+constexpr size_t DMA_INPUT_SITES_COUNT = 16;
+
+struct TestBlobOptions {
+    // relocations in the packed encoding (VPU_SHT_RELA_PACKED) instead of SHT_RELA
+    bool packing = true;
+    // PT_LOAD segments, see Writer::setLoadSegments
+    bool loadSegments = false;
+    // a profiling-only section, a profiling output and the relocations referencing them
+    bool profiling = false;
+    // bytes of the read-only .weights section
+    size_t weightsSize = WEIGHTS_SIZE;
+    // value written to the bytes of .weights, blobs with the same value have byte-identical weights
+    uint8_t weightsValue = 0x5A;
+    // an output, the metadata, the platform info and the version notes a HostParsedInference reads at construction
+    bool hostParsedInference = false;
+    platform::ArchKind archKind = platform::ArchKind::VPUX37XX;
+    Version elfABIVersion = Version();
+    Version miVersion = Version();
+};
+
+/**
+ * Blob with the kinds of sections the loader handles:
+ *  - .text.dma: writable, relocated at load (strided runs) and per inference (JIT relocations against the input)
+ *  - .weights: read-only, shared by the loader copies
+ *  - .text.mi: writable, relocated at load against .symtab (MI_SITES_COUNT R_VPU_64 sites, scattered) and against
+ *    the runtime symbols (MI_RUNTIME_SITES_COUNT R_VPU_32 sites)
+ *  - .data: writable, not relocated
+ *  - .scratch, .bss: empty, writable
+ *  - with profiling, .profiling: profiling-only, referenced by a .text.mi site and patched itself, and a profiling
+ *    output referenced by MI_PROFILING_OUTPUT_SITES_COUNT JIT relocations of .text.mi
+ *  - with hostParsedInference, an FP32 output and the metadata describing the FP16 input and the output
+ */
+inline std::vector<uint8_t> buildTestBlob(const TestBlobOptions& options = {}) {
+    Writer writer;
+    writer.setLoadSegments(options.loadSegments);
+
+    auto symTab = writer.addSymbolSection(".symtab");
+    auto inputsSymTab = writer.addSymbolSection(".inputs");
+    inputsSymTab->maskFlags(VPU_SHF_USERINPUT);
+    auto input = inputsSymTab->addSymbolEntry("input");
+    input->setSize(INPUT_SIZE);
+
+    auto dma = writer.addBinaryDataSection<uint8_t>(".text.dma");
+    dma->setFlags(SHF_ALLOC | SHF_WRITE | VPU_SHF_PROC_DMA);
+    dma->setAddrAlign(64);
+    dma->setSize(DMA_SIZE);
+    auto weights = writer.addBinaryDataSection<uint8_t>(".weights");
+    weights->setFlags(SHF_ALLOC | VPU_SHF_PROC_DMA);
+    weights->setAddrAlign(64);
+    weights->setSize(options.weightsSize);
+    auto mi = writer.addBinaryDataSection<uint8_t>(".text.mi");
+    mi->setFlags(SHF_ALLOC | SHF_WRITE | VPU_SHF_PROC_DMA);
+    mi->setSize(MI_SIZE);
+    auto data = writer.addBinaryDataSection<uint8_t>(".data");
+    data->setFlags(SHF_ALLOC | SHF_WRITE);
+    data->setAddrAlign(64);
+    data->setSize(DATA_SIZE);
+    auto scratch = writer.addEmptySection(".scratch");
+    scratch->setFlags(SHF_ALLOC | SHF_WRITE);
+    scratch->setAddrAlign(64);
+    scratch->setSize(SCRATCH_SIZE);
+    auto bss = writer.addEmptySection(".bss");
+    bss->setFlags(SHF_ALLOC | SHF_WRITE);
+    bss->setAddrAlign(64);
+    bss->setSize(BSS_SIZE);
+
+    auto weightsSymbol = symTab->addSymbolEntry("weights");
+    weightsSymbol->setRelatedSection(weights);
+    weightsSymbol->setValue(16);
+    auto scratchSymbol = symTab->addSymbolEntry("scratch");
+    scratchSymbol->setRelatedSection(scratch);
+    scratchSymbol->setValue(32);
+    auto dmaSymbol = symTab->addSymbolEntry("dma");
+    dmaSymbol->setRelatedSection(dma);
+    auto entrySymbol = symTab->addSymbolEntry("entry");
+    entrySymbol->setRelatedSection(mi);
+    entrySymbol->setType(VPU_STT_ENTRY);
+
+    std::vector<writer::RelocationSection*> relocationSections;
+
+    // strided runs, which the packed encoding folds
+    auto dmaRelocations = writer.addRelocationSection(".rela.dma");
+    dmaRelocations->setSymbolTable(symTab);
+    dmaRelocations->setSectionToPatch(dma);
+    const writer::Symbol* symbols[] = {weightsSymbol, scratchSymbol, dmaSymbol};
+    const Elf_Word types[] = {R_VPU_64, R_VPU_32, R_VPU_32_SUM, R_VPU_64_OR, R_VPU_LO_21, R_VPU_16_SUM};
+    for (size_t runIdx = 0; runIdx < 12; ++runIdx) {
+        for (size_t siteIdx = 0; siteIdx < 64; ++siteIdx) {
+            auto relocation = dmaRelocations->addRelocationEntry();
+            relocation->setOffset((runIdx * 64 + siteIdx) * 16);
+            relocation->setSymbol(symbols[runIdx % 3]);
+            relocation->setType(types[runIdx % 6]);
+            relocation->setAddend(runIdx * 8);
+        }
+    }
+    relocationSections.push_back(dmaRelocations);
+
+    // scattered sites with varying addends, see getMiSiteOffset
+    auto miRelocations = writer.addRelocationSection(".rela.mi");
+    miRelocations->setSymbolTable(symTab);
+    miRelocations->setSectionToPatch(mi);
+    for (size_t siteIdx = 0; siteIdx < MI_SITES_COUNT; ++siteIdx) {
+        auto relocation = miRelocations->addRelocationEntry();
+        relocation->setOffset(((siteIdx * 7) % MI_SITES_COUNT) * 8);
+        relocation->setSymbol(symbols[siteIdx % 3]);
+        relocation->setType(R_VPU_64);
+        relocation->setAddend(siteIdx * 64);
+    }
+    relocationSections.push_back(miRelocations);
+
+    auto runtimeRelocations = writer.addRelocationSection(".rela.rt");
+    runtimeRelocations->setSpecialSymbolTable(VPU_RT_SYMTAB);
+    runtimeRelocations->setSectionToPatch(mi);
+    for (size_t siteIdx = 0; siteIdx < MI_RUNTIME_SITES_COUNT; ++siteIdx) {
+        auto relocation = runtimeRelocations->addRelocationEntry();
+        relocation->setOffset(MI_RUNTIME_SITES_OFFSET + siteIdx * 4);
+        relocation->setSpecialSymbol(siteIdx % 3);
+        relocation->setType(R_VPU_32);
+        relocation->setAddend(siteIdx);
+    }
+    relocationSections.push_back(runtimeRelocations);
+
+    auto jitRelocations = writer.addRelocationSection(".rela.jit");
+    jitRelocations->setSymbolTable(inputsSymTab);
+    jitRelocations->setSectionToPatch(dma);
+    jitRelocations->maskFlags(VPU_SHF_JIT | VPU_SHF_USERINPUT);
+    for (size_t siteIdx = 0; siteIdx < DMA_INPUT_SITES_COUNT; ++siteIdx) {
+        auto relocation = jitRelocations->addRelocationEntry();
+        relocation->setOffset(DMA_SIZE - 8 - siteIdx * 16);
+        relocation->setSymbol(input);
+        relocation->setType(R_VPU_64);
+        relocation->setAddend(siteIdx * 32);
+    }
+    relocationSections.push_back(jitRelocations);
+
+    writer::BinaryDataSection<uint8_t>* profiling = nullptr;
+    if (options.profiling) {
+        profiling = writer.addBinaryDataSection<uint8_t>(".profiling");
+        profiling->setFlags(SHF_ALLOC | SHF_WRITE | VPU_SHF_PROFOUTPUT);
+        profiling->setAddrAlign(64);
+        profiling->setSize(PROFILING_SIZE);
+        auto profilingSymbol = symTab->addSymbolEntry("profiling");
+        profilingSymbol->setRelatedSection(profiling);
+
+        auto miProfilingRelocations = writer.addRelocationSection(".rela.mi.profiling");
+        miProfilingRelocations->setSymbolTable(symTab);
+        miProfilingRelocations->setSectionToPatch(mi);
+        auto relocation = miProfilingRelocations->addRelocationEntry();
+        relocation->setOffset(MI_PROFILING_SITE_OFFSET);
+        relocation->setSymbol(profilingSymbol);
+        relocation->setType(R_VPU_64);
+        relocation->setAddend(8);
+        relocationSections.push_back(miProfilingRelocations);
+
+        // relocations of the profiling-only section itself
+        auto profilingRelocations = writer.addRelocationSection(".rela.profiling");
+        profilingRelocations->setSymbolTable(symTab);
+        profilingRelocations->setSectionToPatch(profiling);
+        relocation = profilingRelocations->addRelocationEntry();
+        relocation->setOffset(0);
+        relocation->setSymbol(dmaSymbol);
+        relocation->setType(R_VPU_64);
+        relocationSections.push_back(profilingRelocations);
+
+        auto profilingOutputsSymTab = writer.addSymbolSection(".profiling.outputs");
+        profilingOutputsSymTab->maskFlags(VPU_SHF_PROFOUTPUT);
+        auto profilingOutput = profilingOutputsSymTab->addSymbolEntry("profilingOutput");
+        profilingOutput->setSize(PROFILING_OUTPUT_SIZE);
+        auto profilingOutputRelocations = writer.addRelocationSection(".rela.profiling.outputs");
+        profilingOutputRelocations->setSymbolTable(profilingOutputsSymTab);
+        profilingOutputRelocations->setSectionToPatch(mi);
+        profilingOutputRelocations->maskFlags(VPU_SHF_JIT | VPU_SHF_PROFOUTPUT);
+        for (size_t siteIdx = 0; siteIdx < MI_PROFILING_OUTPUT_SITES_COUNT; ++siteIdx) {
+            relocation = profilingOutputRelocations->addRelocationEntry();
+            relocation->setOffset(MI_PROFILING_OUTPUT_SITES_OFFSET + siteIdx * 8);
+            relocation->setSymbol(profilingOutput);
+            relocation->setType(R_VPU_64);
+            relocation->setAddend(siteIdx * 16);
+        }
+        relocationSections.push_back(profilingOutputRelocations);
+    }
+
+    for (auto relocationSection : relocationSections) {
+        relocationSection->setPackingEnabled(options.packing);
+    }
+
+    std::vector<uint8_t> metadataData;
+    std::vector<uint8_t> platformInfoData;
+    std::vector<elf_note::VersionNote> versionNotes;
+    std::vector<writer::BinaryDataSection<uint8_t>*> hpiSections;
+    if (options.hostParsedInference) {
+        auto outputsSymTab = writer.addSymbolSection(".outputs");
+        outputsSymTab->maskFlags(VPU_SHF_USEROUTPUT);
+        outputsSymTab->addSymbolEntry("output")->setSize(OUTPUT_SIZE);
+
+        NetworkMetadata metadata;
+        metadata.mResourceRequirements.nn_slice_count_ = platform::getHardwareTileCount(options.archKind);
+        metadata.mNetInputs.resize(1);
+        metadata.mNetInputs[0].data_type = DType_FP16;
+        metadata.mNetOutputs.resize(1);
+        metadata.mNetOutputs[0].data_type = DType_FP32;
+        metadataData = MetadataSerialization::serialize(metadata);
+        platform::PlatformInfo platformInfo{options.archKind};
+        platformInfoData = platform::PlatformInfoSerialization::serialize(platformInfo);
+
+        const std::pair<uint32_t, Version> versions[] = {{elf_note::NT_GNU_ABI_TAG, options.elfABIVersion},
+                                                         {elf_note::NT_NPU_MPI_VERSION, options.miVersion}};
+        for (const auto& version : versions) {
+            elf_note::VersionNote note{};
+            note.n_namesz = sizeof(note.n_name);
+            note.n_descz = sizeof(note.n_desc);
+            note.n_type = version.first;
+            note.n_desc[1] = version.second.getMajor();
+            note.n_desc[2] = version.second.getMinor();
+            note.n_desc[3] = version.second.getPatch();
+            versionNotes.push_back(note);
+        }
+
+        hpiSections.push_back(writer.addBinaryDataSection<uint8_t>(".metadata", VPU_SHT_NETDESC));
+        hpiSections.push_back(writer.addBinaryDataSection<uint8_t>(".platform_info", VPU_SHT_PLATFORM_INFO));
+        hpiSections.push_back(writer.addBinaryDataSection<uint8_t>(".note.abi", SHT_NOTE));
+        hpiSections.push_back(writer.addBinaryDataSection<uint8_t>(".note.mi", SHT_NOTE));
+        hpiSections[0]->setSize(metadataData.size());
+        hpiSections[1]->setSize(platformInfoData.size());
+        hpiSections[2]->setSize(sizeof(elf_note::VersionNote));
+        hpiSections[3]->setSize(sizeof(elf_note::VersionNote));
+    }
+
+    // the section data is written in place, once the layout of the blob is known
+    writer.prepareWriter();
+    std::vector<uint8_t> blob(writer.getTotalSize());
+    writer.setSectionsStartAddr(blob.data());
+
+    std::vector<uint8_t> dmaData(DMA_SIZE);
+    for (size_t idx = 0; idx < DMA_SIZE; ++idx) {
+        dmaData[idx] = static_cast<uint8_t>((idx * 31 + 7) & 0x0f);
+    }
+    dma->appendData(dmaData.data(), dmaData.size());
+    const std::vector<uint8_t> weightsData(options.weightsSize, options.weightsValue);
+    weights->appendData(weightsData.data(), weightsData.size());
+    const std::vector<uint8_t> miData(MI_SIZE, 0);
+    mi->appendData(miData.data(), miData.size());
+    std::vector<uint8_t> dataData(DATA_SIZE);
+    for (size_t idx = 0; idx < DATA_SIZE; ++idx) {
+        dataData[idx] = static_cast<uint8_t>(idx);
+    }
+    data->appendData(dataData.data(), dataData.size());
+    if (profiling) {
+        const std::vector<uint8_t> profilingData(PROFILING_SIZE, 0);
+        profiling->appendData(profilingData.data(), profilingData.size());
+    }
+    if (options.hostParsedInference) {
+        hpiSections[0]->appendData(metadataData.data(), metadataData.size());
+        hpiSections[1]->appendData(platformInfoData.data(), platformInfoData.size());
+        for (size_t noteIdx = 0; noteIdx < versionNotes.size(); ++noteIdx) {
+            hpiSections[2 + noteIdx]->appendData(reinterpret_cast<const uint8_t*>(&versionNotes[noteIdx]),
+                                                 sizeof(elf_note::VersionNote));
+        }
+    }
+
+    writer.generateELF(blob.data());
+    return blob;
+}
+
+// Runtime symbols the tests load the blob with
+inline std::vector<SymbolEntry> getTestRuntimeSymbols() {
+    std::vector<SymbolEntry> runtimeSymbols(3);
+    for (size_t symbolIdx = 0; symbolIdx < runtimeSymbols.size(); ++symbolIdx) {
+        runtimeSymbols[symbolIdx] = {};
+        runtimeSymbols[symbolIdx].st_value = 0x2E000000 + symbolIdx * 0x100;
+        runtimeSymbols[symbolIdx].st_size = 16;
+    }
+    return runtimeSymbols;
+}
+
+// User buffers the JIT relocations are applied with
+struct TestIO {
+    std::vector<DeviceBuffer> inputs = {DeviceBuffer(nullptr, 0xA0000000, INPUT_SIZE)};
+    std::vector<DeviceBuffer> outputs;
+    std::vector<DeviceBuffer> profiling;
+
+    explicit TestIO(bool withProfiling = false) {
+        if (withProfiling) {
+            profiling.emplace_back(nullptr, 0xC0000000, PROFILING_OUTPUT_SIZE);
+        }
+    }
+};
+
+// The sections accessed by the NPU are read straight into device buffers, so that their addresses don't depend on the
+// blob they come from
+inline std::shared_ptr<AccessManager> makeAccessManager(const std::vector<uint8_t>& blob,
+                                                        BufferManager* bufferManager) {
+    return std::make_shared<DDRAccessManager<DDRNeverEmplace, HybridBufferFactory>>(
+            blob.data(), blob.size(), std::make_shared<HybridBufferFactory>(bufferManager));
+}
+
+// Loads with the test runtime symbols, then applies the JIT relocations with io
+inline void loadAndApplyIO(VPUXLoader& loader, TestIO& io) {
+    loader.load(getTestRuntimeSymbols());
+    loader.applyJitRelocations(io.inputs, io.outputs, io.profiling);
+}
+
+using PatchedBuffers = std::vector<std::pair<uint64_t /*vpu address*/, std::vector<uint8_t> /*contents*/>>;
+
+// Contents of the device buffers of a loader, ordered by address
+inline PatchedBuffers getPatchedBuffers(const VPUXLoader& loader) {
+    PatchedBuffers buffers;
+    for (const auto& buffer : loader.getAllocatedBuffers()) {
+        if (buffer.cpu_addr()) {
+            buffers.emplace_back(buffer.vpu_addr(),
+                                 std::vector<uint8_t>(buffer.cpu_addr(), buffer.cpu_addr() + buffer.size()));
+        }
+    }
+    std::sort(buffers.begin(), buffers.end());
+    return buffers;
+}
+
+// Buffer of the section of the given size, see the sizes of the test blob
+inline DeviceBuffer findBuffer(const VPUXLoader& loader, size_t size) {
+    for (const auto& buffer : loader.getAllocatedBuffers()) {
+        if (buffer.size() == size) {
+            return buffer;
+        }
+    }
+    return DeviceBuffer();
+}
+
+template <typename T>
+T readValue(const DeviceBuffer& buffer, size_t offset) {
+    T value{};
+    std::memcpy(&value, buffer.cpu_addr() + offset, sizeof(value));
+    return value;
+}
+
+inline bool check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << '\n';
+    }
+    return condition;
+}
+
+/**
+ * Checks the sites of .text.mi and the input sites of .text.dma against the addresses of the sections of the loader.
+ * The profiling sites are checked when profilingAddress (address of .profiling) and profilingOutputAddress are set.
+ */
+inline bool checkPatchSites(const VPUXLoader& loader, const TestIO& io, uint64_t profilingAddress = 0,
+                            uint64_t profilingOutputAddress = 0) {
+    const auto mi = findBuffer(loader, MI_SIZE);
+    const auto dma = findBuffer(loader, DMA_SIZE);
+    const auto weights = findBuffer(loader, WEIGHTS_SIZE);
+    const auto scratch = findBuffer(loader, SCRATCH_SIZE);
+    if (!check(mi.cpu_addr() && dma.cpu_addr() && weights.vpu_addr() && scratch.vpu_addr(),
+               "the sections of the test blob are not all loaded")) {
+        return false;
+    }
+
+    bool passed = true;
+    // symbols of .symtab used by .rela.mi: weights + 16, scratch + 32, dma
+    const uint64_t symbolAddresses[] = {weights.vpu_addr() + 16, scratch.vpu_addr() + 32, dma.vpu_addr()};
+    for (size_t siteIdx = 0; siteIdx < MI_SITES_COUNT; ++siteIdx) {
+        const auto value = readValue<uint64_t>(mi, ((siteIdx * 7) % MI_SITES_COUNT) * 8);
+        passed &= check(value == symbolAddresses[siteIdx % 3] + siteIdx * 64, "wrong .text.mi patch site");
+    }
+
+    const auto runtimeSymbols = getTestRuntimeSymbols();
+    for (size_t siteIdx = 0; siteIdx < MI_RUNTIME_SITES_COUNT; ++siteIdx) {
+        const auto value = readValue<uint32_t>(mi, MI_RUNTIME_SITES_OFFSET + siteIdx * 4);
+        passed &= check(value == static_cast<uint32_t>(runtimeSymbols[siteIdx % 3].st_value + siteIdx),
+                        "wrong runtime symbol patch site");
+    }
+
+    for (size_t siteIdx = 0; siteIdx < DMA_INPUT_SITES_COUNT; ++siteIdx) {
+        const auto value = readValue<uint64_t>(dma, DMA_SIZE - 8 - siteIdx * 16);
+        passed &= check(value == io.inputs.front().vpu_addr() + siteIdx * 32, "wrong input patch site");
+    }
+
+    if (profilingAddress) {
+        passed &= check(readValue<uint64_t>(mi, MI_PROFILING_SITE_OFFSET) == profilingAddress + 8,
+                        "wrong profiling patch site");
+    }
+    if (profilingOutputAddress) {
+        for (size_t siteIdx = 0; siteIdx < MI_PROFILING_OUTPUT_SITES_COUNT; ++siteIdx) {
+            const auto value = readValue<uint64_t>(mi, MI_PROFILING_OUTPUT_SITES_OFFSET + siteIdx * 8);
+            passed &= check(value == profilingOutputAddress + siteIdx * 16, "wrong profiling output patch site");
+        }
+    }
+    return passed;
+}
+
+/**
+ * Runs the test cases, an exception fails the case throwing it. Returns the exit code of the test
+ */
+inline int runTests(const std::vector<std::pair<const char*, std::function<bool()>>>& testCases) {
+    bool passed = true;
+    for (const auto& testCase : testCases) {
+        bool casePassed = false;
+        try {
+            casePassed = testCase.second();
+        } catch (const std::exception& exception) {
+            std::cerr << "FAILED: " << exception.what() << '\n';
+        }
+        std::cout << (casePassed ? "PASSED " : "FAILED ") << testCase.first << '\n';
+        passed &= casePassed;
+    }
+    return passed ? 0 : 1;
+}
+
+}  // namespace test
+}  // namespace elf
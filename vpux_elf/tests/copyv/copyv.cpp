@@ -0,0 +1,106 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// The uploads of the sections are submitted with a single BufferManager::copyv call per BufferManager
+
+#include "../common/test_utils.hpp"
+
+#include <vpux_headers/managed_buffer.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+// Relies on the default copyv, which goes through copy and copyAt
+class SerialCopyBufferManager final : public TestBufferManager {
+public:
+    size_t copyv(const std::vector<BufferCopy>& copies) override {
+        return BufferManager::copyv(copies);
+    }
+};
+
+bool testLoader(bool arenaAllocations) {
+    const auto blob = buildTestBlob({});
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    loader.setArenaAllocations(arenaAllocations);
+    TestIO io;
+    loadAndApplyIO(loader, io);
+
+    const auto calls = bufferManager.getCalls();
+    bool passed = checkPatchSites(loader, io);
+    passed &= check(calls.copyv == 1, "the uploads of the sections were not submitted at once");
+    passed &= check(calls.violations == 0, "the loader broke the BufferManager contract");
+    return passed;
+}
+
+bool testLoadMany() {
+    TestBufferManager firstManager;
+    TestBufferManager secondManager;
+    AllocatedDeviceBuffer first(&firstManager, BufferSpecs(64, 128, 0));
+    AllocatedDeviceBuffer second(&firstManager, BufferSpecs(64, 256, 0));
+    auto arena = std::make_shared<DeviceBufferArena>(&secondManager, BufferSpecs(64, 512, 0));
+    ArenaBufferView view(arena, 256, BufferSpecs(64, 64, 0));
+
+    const std::vector<uint8_t> firstData(128, 1);
+    const std::vector<uint8_t> secondData(256, 2);
+    const std::vector<uint8_t> viewData(64, 3);
+    {
+        ElfBufferBatchLockGuard batchLock({&first, &second, &view});
+        ManagedBuffer::loadMany({{&first, firstData.data(), firstData.size()},
+                                 {&second, secondData.data(), secondData.size()},
+                                 {&view, viewData.data(), viewData.size()}});
+    }
+
+    bool passed = check(firstManager.getCalls().copyv == 1 && secondManager.getCalls().copyv == 1,
+                        "the loads were not submitted with a copyv call per BufferManager");
+    passed &= check(firstManager.getCalls().copy == 0 && secondManager.getCalls().copy == 0,
+                    "some loads were not submitted with copyv");
+    passed &= check(std::equal(firstData.begin(), firstData.end(), first.getBuffer().cpu_addr()) &&
+                            std::equal(secondData.begin(), secondData.end(), second.getBuffer().cpu_addr()),
+                    "wrong bytes loaded");
+    // the view is loaded at its offset inside the arena
+    const auto arenaBuffer = arena->getBuffer();
+    passed &= check(std::equal(viewData.begin(), viewData.end(), arenaBuffer.cpu_addr() + 256) &&
+                            arenaBuffer.cpu_addr()[255] == 0xCD && arenaBuffer.cpu_addr()[320] == 0xCD,
+                    "the view was not loaded at its offset");
+    passed &= check(firstManager.getCalls().violations == 0 && secondManager.getCalls().violations == 0,
+                    "loadMany broke the BufferManager contract");
+    return passed;
+}
+
+bool testDefaultCopyv() {
+    const auto blob = buildTestBlob({});
+    SerialCopyBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    TestIO io;
+    loadAndApplyIO(loader, io);
+
+    const auto calls = bufferManager.getCalls();
+    bool passed = checkPatchSites(loader, io);
+    passed &= check(calls.copy != 0 || calls.copyAt != 0, "the default copyv doesn't copy");
+    passed &= check(calls.violations == 0, "the default copyv broke the BufferManager contract");
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"loader", std::bind(testLoader, false)},
+            {"loader with arenas", std::bind(testLoader, true)},
+            {"loadMany", testLoadMany},
+            {"default copyv", testDefaultCopyv},
+    });
+}
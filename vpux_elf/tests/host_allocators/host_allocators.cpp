@@ -0,0 +1,136 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// Host allocation policies: the allocations honour the requested size and alignment, report the policy which served
+// them, and the DynamicBuffers of a load come out of the allocator given to the buffer factory
+
+#include "../common/test_utils.hpp"
+
+#include <vpux_elf/utils/error.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+bool isAligned(const void* ptr, size_t alignment) {
+    return !(reinterpret_cast<uintptr_t>(ptr) & (alignment - 1));
+}
+
+// Allocates, fills and frees size bytes with the given alignment
+bool checkAllocation(HostAllocator& allocator, size_t size, size_t alignment, HostAllocationPolicy policy) {
+    const auto allocation = allocator.allocate(size, alignment);
+    std::memset(allocation.ptr, 0xAB, size);
+
+    bool passed = check(allocation.ptr && isAligned(allocation.ptr, alignment), "misaligned host allocation");
+    passed &= check(allocation.size >= size && allocation.alignment >= alignment,
+                    "the host allocation is smaller than requested");
+    passed &= check(allocation.policy == policy, "unexpected host allocation policy");
+    allocator.deallocate(allocation);
+    return passed;
+}
+
+bool testAligned() {
+    AlignedHostAllocator allocator;
+    bool passed = true;
+    for (const size_t alignment : {1, 8, 64, 4096}) {
+        passed &= checkAllocation(allocator, 100, alignment, HostAllocationPolicy::ALIGNED_NEW);
+    }
+    return passed;
+}
+
+bool testHugePages() {
+    constexpr size_t MIN_HUGE_PAGE_SIZE = 64 * 1024;
+    HugePageHostAllocator allocator(MIN_HUGE_PAGE_SIZE);
+
+    // below the threshold the allocations fall back to aligned operator new
+    bool passed = checkAllocation(allocator, MIN_HUGE_PAGE_SIZE - 1, 64, HostAllocationPolicy::ALIGNED_NEW);
+
+    const auto allocation = allocator.allocate(MIN_HUGE_PAGE_SIZE, 64);
+    std::memset(allocation.ptr, 0xAB, MIN_HUGE_PAGE_SIZE);
+    if (allocation.policy == HostAllocationPolicy::HUGE_PAGES) {
+        passed &= check(isAligned(allocation.ptr, HugePageHostAllocator::HUGE_PAGE_SIZE) &&
+                                allocation.size % HugePageHostAllocator::HUGE_PAGE_SIZE == 0,
+                        "the mapping is not trimmed to huge page boundaries");
+    } else {
+        // platforms without mmap and failed mappings
+        passed &= check(allocation.policy == HostAllocationPolicy::ALIGNED_NEW && isAligned(allocation.ptr, 64),
+                        "unexpected huge page fallback");
+    }
+    allocator.deallocate(allocation);
+
+    try {
+        allocator.allocate(MIN_HUGE_PAGE_SIZE, 48);
+    } catch (const ArgsError&) {
+        return passed;
+    }
+    return check(false, "an alignment which is not a power of 2 was accepted");
+}
+
+bool testCallback() {
+    RecordingHostAllocator recordingAllocator;
+    bool passed =
+            checkAllocation(*recordingAllocator.getAllocator(), 100, 256, HostAllocationPolicy::USER_CALLBACK);
+    passed &= check(recordingAllocator.hasAllocated(100) && recordingAllocator.getLiveAllocationsCount() == 0,
+                    "the callbacks were not called");
+
+    // callbacks failing to allocate or returning misaligned memory
+    alignas(64) static uint8_t storage[128];
+    for (auto result : {static_cast<void*>(nullptr), static_cast<void*>(storage + 1)}) {
+        CallbackHostAllocator failingAllocator(
+                [result](size_t, size_t) {
+                    return result;
+                },
+                [](void*, size_t) {});
+        try {
+            failingAllocator.allocate(64, 64);
+            passed &= check(false, "a failed callback allocation was accepted");
+        } catch (const AllocError&) {
+        }
+    }
+    return passed;
+}
+
+bool testLoad() {
+    const auto blob = buildTestBlob({});
+    RecordingHostAllocator recordingAllocator;
+
+    bool passed = true;
+    {
+        TestBufferManager bufferManager;
+        auto accessor = std::make_shared<DDRAccessManager<DDRNeverEmplace, HybridBufferFactory>>(
+                blob.data(), blob.size(),
+                std::make_shared<HybridBufferFactory>(&bufferManager, recordingAllocator.getAllocator()));
+        VPUXLoader loader(accessor.get(), &bufferManager);
+        TestIO io;
+        loadAndApplyIO(loader, io);
+
+        passed &= checkPatchSites(loader, io);
+        passed &= check(recordingAllocator.getAllocationsCount() > 0,
+                        "the host buffers of the load ignored the allocator of the factory");
+
+        DynamicBuffer buffer(BufferSpecs(64, 100, 0), recordingAllocator.getAllocator());
+        passed &= check(buffer.getHostAllocationPolicy() == HostAllocationPolicy::USER_CALLBACK,
+                        "the DynamicBuffer reports the wrong host allocation policy");
+    }
+    passed &= check(recordingAllocator.getLiveAllocationsCount() == 0, "the load leaks host allocations");
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"aligned", testAligned},
+            {"huge pages", testHugePages},
+            {"callback", testCallback},
+            {"load", testLoad},
+    });
+}
@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// Monotonic host arena: the allocations are carved out of a few blocks, which are released together once every
+// allocation is gone, and a loader reading through a HostArenaBufferFactory gets its host buffers out of it
+
+#include "../common/test_utils.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+constexpr size_t BLOCK_SIZE = 4096;
+
+bool testCarving() {
+    RecordingHostAllocator blockAllocator;
+    MonotonicHostAllocator arena(BLOCK_SIZE, blockAllocator.getAllocator());
+
+    std::vector<HostAllocation> allocations;
+    for (size_t allocationIdx = 0; allocationIdx < 10; ++allocationIdx) {
+        allocations.push_back(arena.allocate(100, 64));
+        std::memset(allocations.back().ptr, static_cast<int>(allocationIdx), 100);
+    }
+
+    bool passed = true;
+    for (size_t allocationIdx = 0; allocationIdx < allocations.size(); ++allocationIdx) {
+        const auto bytes = static_cast<const uint8_t*>(allocations[allocationIdx].ptr);
+        passed &= check(!(reinterpret_cast<uintptr_t>(bytes) & 63) &&
+                                allocations[allocationIdx].policy == HostAllocationPolicy::MONOTONIC_ARENA,
+                        "misaligned arena allocation");
+        passed &= check(bytes[0] == allocationIdx && bytes[99] == allocationIdx, "overlapping arena allocations");
+    }
+    auto stats = arena.getArenaStats();
+    passed &= check(stats.blocks == 1 && stats.reservedSize == BLOCK_SIZE && stats.usedSize == 1000 &&
+                            stats.liveAllocations == 10 && blockAllocator.getAllocationsCount() == 1,
+                    "the small allocations were not carved out of a single block");
+
+    // larger than a block: dedicated block, the carved one keeps serving the small allocations
+    allocations.push_back(arena.allocate(2 * BLOCK_SIZE, 64));
+    allocations.push_back(arena.allocate(100, 64));
+    stats = arena.getArenaStats();
+    passed &= check(stats.blocks == 2 && stats.reservedSize == 3 * BLOCK_SIZE &&
+                            blockAllocator.getAllocationsCount() == 2,
+                    "the large allocation did not get a dedicated block");
+
+    for (const auto& allocation : allocations) {
+        arena.deallocate(allocation);
+    }
+    stats = arena.getArenaStats();
+    passed &= check(stats.blocks == 1 && stats.usedSize == 0 && stats.liveAllocations == 0 &&
+                            blockAllocator.getLiveAllocationsCount() == 1,
+                    "the arena was not released once every allocation was gone");
+
+    // the kept block is rewound for the next load
+    const auto allocation = arena.allocate(BLOCK_SIZE, 64);
+    passed &= check(blockAllocator.getAllocationsCount() == 2, "the kept block was not reused");
+    arena.deallocate(allocation);
+
+    try {
+        arena.deallocate(allocation);
+    } catch (const SequenceError&) {
+        return passed;
+    }
+    return check(false, "a deallocation without a live allocation was accepted");
+}
+
+bool testLoad() {
+    const auto blob = buildTestBlob({});
+    auto bufferFactory = std::make_shared<HostArenaBufferFactory>(BLOCK_SIZE);
+    const auto& arena = bufferFactory->getHostArena();
+
+    bool passed = true;
+    {
+        TestBufferManager bufferManager;
+        DDRAccessManager<DDRNeverEmplace, HostArenaBufferFactory> accessor(blob.data(), blob.size(), bufferFactory);
+        VPUXLoader loader(&accessor, &bufferManager);
+        TestIO io;
+        loadAndApplyIO(loader, io);
+
+        passed &= checkPatchSites(loader, io);
+        const auto stats = arena->getArenaStats();
+        passed &= check(stats.liveAllocations > stats.blocks,
+                        "the host buffers of the load were not carved out of the arena");
+        passed &= check(bufferManager.getCalls().violations == 0, "the loader broke the BufferManager contract");
+    }
+    const auto stats = arena->getArenaStats();
+    passed &= check(stats.liveAllocations == 0 && stats.usedSize == 0 && stats.blocks <= 1,
+                    "the arena was not released with the loader");
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"carving", testCarving},
+            {"load", testLoad},
+    });
+}
@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// IO buffer slab: the IO buffers of several inference requests come out of a single BufferManager allocation, are
+// aligned and disjoint, and patch the JIT relocation sites of the HostParsedInference they are applied to
+
+#include "../common/test_utils.hpp"
+
+#include <io_buffer_slab.hpp>
+#include <vpux_hpi.hpp>
+
+#include <cstdint>
+#include <functional>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+constexpr size_t REQUESTS_COUNT = 3;
+
+// The bytes of the R_VPU_64 JIT relocation sites of .text.dma address the given input
+bool checkInputSites(HostParsedInference& hpi, const DeviceBuffer& input) {
+    for (const auto& buffer : hpi.getAllocatedBuffers()) {
+        if (buffer.size() != DMA_SIZE) {
+            continue;
+        }
+        bool passed = true;
+        for (size_t siteIdx = 0; siteIdx < DMA_INPUT_SITES_COUNT; ++siteIdx) {
+            passed &= readValue<uint64_t>(buffer, DMA_SIZE - 8 - siteIdx * 16) ==
+                      input.vpu_addr() + siteIdx * 32;
+        }
+        return check(passed, "the JIT relocation sites do not address the input of the request");
+    }
+    return check(false, "no .text.dma buffer");
+}
+
+bool testSlab(bool profiling) {
+    const auto archKind = platform::ArchKind::VPUX37XX;
+    VersionsProvider versionsProvider(archKind);
+    TestBlobOptions blobOptions;
+    blobOptions.profiling = profiling;
+    blobOptions.hostParsedInference = true;
+    blobOptions.archKind = archKind;
+    blobOptions.elfABIVersion = versionsProvider.getLibraryELFVersion();
+    blobOptions.miVersion = versionsProvider.getLibraryMIVersion();
+    const auto blob = buildTestBlob(blobOptions);
+
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    HPIConfigs hpiConfigs;
+    hpiConfigs.archKind = archKind;
+    HostParsedInference hpi(&bufferManager, accessor.get(), hpiConfigs);
+    hpi.load();
+
+    bool passed = true;
+    {
+        const auto allocations = bufferManager.getCalls().allocate;
+        IOBufferSlabOptions slabOptions;
+        slabOptions.profiling = profiling;
+        IOBufferSlab slab(&bufferManager, hpi, REQUESTS_COUNT, slabOptions);
+        passed &= check(bufferManager.getCalls().allocate == allocations + 1 &&
+                                slab.getRequestsCount() == REQUESTS_COUNT,
+                        "the IO buffers were not allocated in a single slab");
+
+        const auto slabBuffer = slab.getSlab();
+        uint64_t nextFreeAddress = slabBuffer.vpu_addr();
+        for (size_t requestIdx = 0; requestIdx < REQUESTS_COUNT; ++requestIdx) {
+            auto& request = slab.getRequestBuffers(requestIdx);
+            passed &= check(request.inputs.size() == 1 && request.inputs[0].size() == INPUT_SIZE &&
+                                    request.outputs.size() == 1 && request.outputs[0].size() == OUTPUT_SIZE &&
+                                    request.profiling.size() == (profiling ? 1 : 0),
+                            "the request buffers do not match the IO descriptors");
+
+            // the buffers of the requests follow each other inside the slab, without overlapping
+            for (const auto buffers : {&request.inputs, &request.outputs, &request.profiling}) {
+                for (const auto& buffer : *buffers) {
+                    passed &= check(buffer.vpu_addr() >= nextFreeAddress && buffer.vpu_addr() % 64 == 0 &&
+                                            buffer.vpu_addr() + buffer.size() <=
+                                                    slabBuffer.vpu_addr() + slabBuffer.size() &&
+                                            buffer.cpu_addr() == slabBuffer.cpu_addr() +
+                                                                         (buffer.vpu_addr() - slabBuffer.vpu_addr()),
+                                    "request buffer outside of the slab, misaligned or overlapping");
+                    nextFreeAddress = buffer.vpu_addr() + buffer.size();
+                }
+            }
+
+            hpi.applyInputOutput(request.inputs, request.outputs, request.profiling);
+            passed &= checkInputSites(hpi, request.inputs[0]);
+        }
+        passed &= check(bufferManager.isLocked(slabBuffer), "the slab is not locked while its buffers are handed out");
+    }
+    passed &= check(bufferManager.getCalls().violations == 0, "the slab broke the BufferManager contract");
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"slab", std::bind(testSlab, false)},
+            {"slab with profiling", std::bind(testSlab, true)},
+    });
+}
@@ -0,0 +1,79 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// Writer -> Reader -> VPUXLoader round trip: the loader patches the sites of the blob with the addresses of its
+// buffers and rejects the blobs with relocations out of their target section
+
+#include "../common/test_utils.hpp"
+
+#include <vpux_elf/utils/error.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+bool testRoundTrip() {
+    const auto blob = buildTestBlob({});
+
+    TestBufferManager firstManager;
+    auto firstAccessor = makeAccessManager(blob, &firstManager);
+    VPUXLoader firstLoader(firstAccessor.get(), &firstManager);
+    TestIO io;
+    loadAndApplyIO(firstLoader, io);
+
+    TestBufferManager secondManager;
+    auto secondAccessor = makeAccessManager(blob, &secondManager);
+    VPUXLoader secondLoader(secondAccessor.get(), &secondManager);
+    loadAndApplyIO(secondLoader, io);
+
+    bool passed = checkPatchSites(firstLoader, io);
+    passed &= check(getPatchedBuffers(firstLoader) == getPatchedBuffers(secondLoader),
+                    "two loads of the same blob patch different bytes");
+    passed &= check(firstManager.getCalls().violations == 0, "the loader broke the BufferManager contract");
+    return passed;
+}
+
+bool testRelocationOutOfBounds() {
+    auto blob = buildTestBlob({/*packing=*/false});
+
+    // move the first site of .rela.mi past the end of .text.mi
+    {
+        DDRAccessManager<DDRAlwaysEmplace> accessor(blob.data(), blob.size());
+        Reader<ELF_Bitness::Elf64> reader(&accessor);
+        for (size_t sectionIdx = 0; sectionIdx < reader.getSectionsNum(); ++sectionIdx) {
+            const auto section = reader.getSection(sectionIdx);
+            if (std::string(section.getName()) == ".rela.mi") {
+                const Elf64_Addr offset = MI_SIZE;
+                std::memcpy(blob.data() + section.getHeader()->sh_offset + offsetof(Elf64_Rela, r_offset), &offset,
+                            sizeof(offset));
+            }
+        }
+    }
+
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    try {
+        VPUXLoader loader(accessor.get(), &bufferManager);
+    } catch (const RelocError&) {
+        return check(bufferManager.getLiveBuffersCount() == 0, "the rejected blob leaks device buffers");
+    }
+    return check(false, "a relocation out of its target section was accepted");
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"round trip", testRoundTrip},
+            {"relocation out of bounds", testRelocationOutOfBounds},
+    });
+}
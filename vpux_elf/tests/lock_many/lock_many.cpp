@@ -0,0 +1,128 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// The buffers the loader works on are locked in batches, with a BufferManager::lockMany call per batch, and every
+// lock is released
+
+#include "../common/test_utils.hpp"
+
+#include <vpux_elf/utils/error.hpp>
+#include <vpux_headers/managed_buffer.hpp>
+
+#include <stdexcept>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+class FailingLockBufferManager final : public TestBufferManager {
+public:
+    void lockMany(const std::vector<DeviceBuffer*>&) override {
+        throw std::runtime_error("lockMany failure");
+    }
+};
+
+bool testLoader() {
+    const auto blob = buildTestBlob({});
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    TestIO io;
+    loadAndApplyIO(loader, io);
+
+    const auto calls = bufferManager.getCalls();
+    bool passed = checkPatchSites(loader, io);
+    passed &= check(calls.lockMany != 0, "the loader doesn't lock its buffers in batches");
+    passed &= check(calls.lockMany == calls.unlockMany, "a batch of buffers was not unlocked");
+    passed &= check(calls.violations == 0, "the loader broke the BufferManager contract");
+    for (const auto& buffer : loader.getAllocatedBuffers()) {
+        passed &= check(!bufferManager.isLocked(buffer), "a buffer was left locked");
+    }
+    return passed;
+}
+
+bool testNestedGuards() {
+    TestBufferManager bufferManager;
+    AllocatedDeviceBuffer first(&bufferManager, BufferSpecs(64, 128, 0));
+    AllocatedDeviceBuffer second(&bufferManager, BufferSpecs(64, 256, 0));
+
+    bool passed = true;
+    {
+        ElfBufferBatchLockGuard batchLock({&first, &second});
+        passed &= check(bufferManager.isLocked(first.getBuffer()) && bufferManager.isLocked(second.getBuffer()),
+                        "the batch was not locked");
+        {
+            // the buffer is already locked by the batch
+            ElfBufferLockGuard lock(&first);
+        }
+        passed &= check(bufferManager.isLocked(first.getBuffer()), "a nested guard unlocked a buffer of the batch");
+    }
+
+    const auto calls = bufferManager.getCalls();
+    passed &= check(calls.lockMany == 1 && calls.unlockMany == 1 && calls.lock == 0 && calls.unlock == 0,
+                    "the batch was not locked with a single lockMany call");
+    passed &= check(!bufferManager.isLocked(first.getBuffer()) && !bufferManager.isLocked(second.getBuffer()),
+                    "the batch was not unlocked");
+    passed &= check(calls.violations == 0, "the lock guards broke the BufferManager contract");
+    return passed;
+}
+
+bool testFailedLock() {
+    FailingLockBufferManager bufferManager;
+    AllocatedDeviceBuffer buffer(&bufferManager, BufferSpecs(64, 128, 0));
+
+    bool throws = false;
+    try {
+        ElfBufferBatchLockGuard batchLock({&buffer});
+    } catch (const std::runtime_error&) {
+        throws = true;
+    }
+    bool passed = check(throws, "the failure of lockMany was not reported");
+
+    // the lock count of the buffer was rolled back, so it can be locked again
+    buffer.lock();
+    buffer.unlock();
+    passed &= check(bufferManager.getCalls().lock == 1 && bufferManager.getCalls().violations == 0,
+                    "the failed batch left the buffer locked");
+    return passed;
+}
+
+bool testUnbalancedUnlock() {
+    TestBufferManager bufferManager;
+    AllocatedDeviceBuffer first(&bufferManager, BufferSpecs(64, 128, 0));
+    AllocatedDeviceBuffer second(&bufferManager, BufferSpecs(64, 256, 0));
+
+    bool passed = true;
+    {
+        ElfBufferBatchLockGuard batchLock({&first, &second});
+        // the batch can't release the lock of first anymore, its destructor must still unlock second
+        first.unlock();
+    }
+    passed &= check(!bufferManager.isLocked(second.getBuffer()), "the other buffers of the batch were not unlocked");
+
+    bool throws = false;
+    try {
+        first.unlock();
+    } catch (const SequenceError&) {
+        throws = true;
+    }
+    passed &= check(throws, "unlocking a buffer that is not locked was accepted");
+    passed &= check(bufferManager.getCalls().violations == 0, "the lock guards broke the BufferManager contract");
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"loader", testLoader},
+            {"nested guards", testNestedGuards},
+            {"failed lock", testFailedLock},
+            {"unbalanced unlock", testUnbalancedUnlock},
+    });
+}
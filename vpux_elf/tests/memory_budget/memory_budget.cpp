@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// The loader accounts for the memory it holds, and refuses to allocate over its budget
+
+#include "../common/test_utils.hpp"
+
+#include <vpux_elf/utils/error.hpp>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+constexpr size_t WRITABLE_SIZE = DMA_SIZE + MI_SIZE + DATA_SIZE + SCRATCH_SIZE + BSS_SIZE;
+
+bool testAccounting() {
+    const auto blob = buildTestBlob({});
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    const auto estimate = loader.estimateLoadMemoryUsage();
+    TestIO io;
+    loadAndApplyIO(loader, io);
+
+    const auto usage = loader.getMemoryUsage();
+    bool passed = check(usage.deviceBytes >= WRITABLE_SIZE && usage.sharedDeviceBytes >= WEIGHTS_SIZE,
+                        "the device buffers are not accounted for");
+    passed &= check(usage.getDeviceBytes() <= estimate.getDeviceBytes() &&
+                            usage.getHostBytes() <= estimate.getHostBytes(),
+                    "load exceeds its estimate");
+    passed &= check(loader.getMemoryUsage(/*includeShared=*/false).sharedDeviceBytes == 0,
+                    "the shared device buffers are accounted for without includeShared");
+
+    const auto peak = loader.getPeakMemoryUsage();
+    passed &= check(peak.getDeviceBytes() >= usage.getDeviceBytes() && peak.getHostBytes() >= usage.getHostBytes(),
+                    "the peak usage is below the current one");
+    return passed;
+}
+
+bool testLoadOverBudget(bool deviceBudget) {
+    const auto blob = buildTestBlob({});
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    const auto estimate = loader.estimateLoadMemoryUsage();
+    const auto allocations = bufferManager.getCalls().allocate;
+
+    MemoryBudget budget;
+    if (deviceBudget) {
+        budget.deviceBytes = estimate.getDeviceBytes() - 1;
+    } else {
+        budget.hostBytes = estimate.getHostBytes() - 1;
+    }
+    loader.setMemoryBudget(budget);
+
+    bool throws = false;
+    try {
+        loader.load(getTestRuntimeSymbols());
+    } catch (const AllocError&) {
+        throws = true;
+    }
+    bool passed = check(throws, "a load over budget was accepted");
+    passed &= check(bufferManager.getCalls().allocate == allocations, "a load over budget allocated buffers");
+
+    // the estimate fits its own budget
+    loader.setMemoryBudget({estimate.getDeviceBytes(), estimate.getHostBytes()});
+    TestIO io;
+    loadAndApplyIO(loader, io);
+    passed &= checkPatchSites(loader, io);
+    return passed;
+}
+
+bool testCopyOverBudget() {
+    const auto blob = buildTestBlob({});
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    TestIO io;
+    loadAndApplyIO(loader, io);
+
+    // a copy shares the read-only sections, only the device buffers of the loader count
+    const auto deviceBytes = loader.getMemoryUsage(/*includeShared=*/false).deviceBytes;
+    loader.setMemoryBudget({deviceBytes, MemoryBudget().hostBytes});
+    bool passed = true;
+    {
+        VPUXLoader copy(loader);
+        passed &= check(copy.getMemoryBudget().deviceBytes == deviceBytes, "the copy doesn't inherit the budget");
+    }
+
+    loader.setMemoryBudget({deviceBytes - 1, MemoryBudget().hostBytes});
+    const auto allocations = bufferManager.getCalls().allocate;
+    bool throws = false;
+    try {
+        VPUXLoader copy(loader);
+    } catch (const AllocError&) {
+        throws = true;
+    }
+    passed &= check(throws, "a copy over budget was accepted");
+    passed &= check(bufferManager.getCalls().allocate == allocations, "a copy over budget allocated buffers");
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"accounting", testAccounting},
+            {"device budget", std::bind(testLoadOverBudget, true)},
+            {"host budget", std::bind(testLoadOverBudget, false)},
+            {"copy budget", testCopyOverBudget},
+    });
+}
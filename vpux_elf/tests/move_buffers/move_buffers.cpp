@@ -0,0 +1,111 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// Moving loader buffers to new device locations must leave every patch site referencing them as a load at the new
+// locations would have patched it
+
+#include "../common/test_utils.hpp"
+
+#include <vpux_elf/utils/error.hpp>
+
+#include <functional>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+// New location holding a copy of the contents of buffer, allocated through bufferManager as moveBuffers requires
+DeviceBuffer copyToNewLocation(TestBufferManager& bufferManager, const DeviceBuffer& buffer) {
+    auto newBuffer = bufferManager.allocate(BufferSpecs(64, buffer.size(), 0));
+    bufferManager.lock(newBuffer);
+    bufferManager.copy(newBuffer, buffer.cpu_addr(), buffer.size());
+    bufferManager.unlock(newBuffer);
+    return newBuffer;
+}
+
+template <typename Exception>
+bool throws(const std::function<void()>& function) {
+    try {
+        function();
+    } catch (const Exception&) {
+        return true;
+    }
+    return false;
+}
+
+bool testMove() {
+    const auto blob = buildTestBlob({});
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    TestIO io;
+    loadAndApplyIO(loader, io);
+
+    // .text.mi only has linear sites, .text.dma has non-linear sites referencing .scratch
+    const auto mi = findBuffer(loader, MI_SIZE);
+    const auto scratch = findBuffer(loader, SCRATCH_SIZE);
+    const auto newMi = copyToNewLocation(bufferManager, mi);
+    const auto newScratch = copyToNewLocation(bufferManager, scratch);
+    loader.moveBuffers({{mi, newMi}, {scratch, newScratch}});
+
+    bool passed = check(findBuffer(loader, MI_SIZE).vpu_addr() == newMi.vpu_addr() &&
+                                findBuffer(loader, SCRATCH_SIZE).vpu_addr() == newScratch.vpu_addr(),
+                        "the loader doesn't report the new locations");
+    passed &= check(!bufferManager.isLive(mi) && !bufferManager.isLive(scratch), "the old buffers were not released");
+    passed &= checkPatchSites(loader, io);
+
+    // first site of the second .rela.dma run: R_VPU_32 against scratch + 32, addend 8
+    const auto dma = findBuffer(loader, DMA_SIZE);
+    passed &= check(readValue<uint32_t>(dma, 64 * 16) == static_cast<uint32_t>(newScratch.vpu_addr() + 32 + 8),
+                    "a site referencing a moved buffer was not updated");
+    passed &= check(bufferManager.getCalls().violations == 0, "the loader broke the BufferManager contract");
+    return passed;
+}
+
+bool testInvalidMoves() {
+    const auto blob = buildTestBlob({});
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    TestIO io;
+    loadAndApplyIO(loader, io);
+    const auto patchedBuffers = getPatchedBuffers(loader);
+
+    const auto mi = findBuffer(loader, MI_SIZE);
+    const auto weights = findBuffer(loader, WEIGHTS_SIZE);
+    auto newMi = copyToNewLocation(bufferManager, mi);
+    auto newWeights = copyToNewLocation(bufferManager, weights);
+
+    bool passed = check(throws<ArgsError>([&] {
+                            loader.moveBuffers({{mi, newMi}, {mi, newMi}});
+                        }),
+                        "a buffer moved twice was accepted");
+    passed &= check(throws<ArgsError>([&] {
+                        loader.moveBuffers({{newMi, mi}});
+                    }),
+                    "a buffer not allocated by the loader was moved");
+    passed &= check(throws<ArgsError>([&] {
+                        loader.moveBuffers({{weights, newWeights}});
+                    }),
+                    "a shared buffer was moved");
+    // a rejected move changes nothing
+    passed &= check(getPatchedBuffers(loader) == patchedBuffers, "a rejected move changed the loader buffers");
+
+    bufferManager.deallocate(newMi);
+    bufferManager.deallocate(newWeights);
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"move", testMove},
+            {"invalid moves", testInvalidMoves},
+    });
+}
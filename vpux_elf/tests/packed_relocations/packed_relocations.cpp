@@ -0,0 +1,93 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// The device buffers patched by the loader must not depend on the relocation encoding, packed or plain, sorted by
+// offset or not
+
+#include "../common/test_utils.hpp"
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+size_t countSectionsOfType(const std::vector<uint8_t>& blob, Elf_Word sectionType) {
+    DDRAccessManager<DDRAlwaysEmplace> accessor(blob.data(), blob.size());
+    Reader<ELF_Bitness::Elf64> reader(&accessor);
+
+    size_t count = 0;
+    for (size_t sectionIdx = 0; sectionIdx < reader.getSectionsNum(); ++sectionIdx) {
+        count += reader.getSection(sectionIdx).getHeader()->sh_type == sectionType;
+    }
+    return count;
+}
+
+PatchedBuffers loadBlob(const std::vector<uint8_t>& blob) {
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    TestIO io;
+    loadAndApplyIO(loader, io);
+    return getPatchedBuffers(loader);
+}
+
+bool testEncoding() {
+    const auto plainBlob = buildTestBlob({/*packing=*/false});
+    const auto packedBlob = buildTestBlob({/*packing=*/true});
+
+    bool passed = check(countSectionsOfType(plainBlob, VPU_SHT_RELA_PACKED) == 0,
+                        "plain blob has packed relocation sections");
+    passed &= check(countSectionsOfType(packedBlob, VPU_SHT_RELA_PACKED) != 0,
+                    "packed blob has no packed relocation section");
+    passed &= check(packedBlob.size() < plainBlob.size(), "packing doesn't shrink the blob");
+    return passed;
+}
+
+// .rela.mi is written in a scattered order, the writer emits it sorted by offset
+bool testSortedEmission() {
+    const auto blob = buildTestBlob({/*packing=*/false});
+    DDRAccessManager<DDRAlwaysEmplace> accessor(blob.data(), blob.size());
+    Reader<ELF_Bitness::Elf64> reader(&accessor);
+
+    bool passed = true;
+    size_t sortedCount = 0;
+    for (size_t sectionIdx = 0; sectionIdx < reader.getSectionsNum(); ++sectionIdx) {
+        const auto section = reader.getSection(sectionIdx);
+        const auto header = section.getHeader();
+        if (header->sh_type != SHT_RELA || !(header->sh_flags & VPU_SHF_RELA_SORTED)) {
+            continue;
+        }
+
+        ++sortedCount;
+        const auto entries = section.getData<Elf64_Rela>();
+        for (size_t entryIdx = 1; entryIdx < section.getEntriesNum(); ++entryIdx) {
+            passed &= check(entries[entryIdx - 1].r_offset < entries[entryIdx].r_offset,
+                            "relocation section flagged as sorted is not sorted by offset");
+        }
+    }
+    passed &= check(sortedCount == 4, "not every relocation section of the test blob is flagged as sorted");
+    return passed;
+}
+
+bool testPackedMatchesPlain() {
+    const auto plainBuffers = loadBlob(buildTestBlob({/*packing=*/false}));
+    const auto packedBuffers = loadBlob(buildTestBlob({/*packing=*/true}));
+
+    bool passed = check(!plainBuffers.empty(), "no buffer was allocated");
+    passed &= check(plainBuffers == packedBuffers, "packed and plain relocations patch different bytes");
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"encoding", testEncoding},
+            {"sorted emission", testSortedEmission},
+            {"packed matches plain", testPackedMatchesPlain},
+    });
+}
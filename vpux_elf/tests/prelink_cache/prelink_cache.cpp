@@ -0,0 +1,153 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// The relocation plan imported from the prelink cache must patch the same bytes as the plan validated from the blob,
+// and an entry the cache can't trust must be ignored
+
+#include "../common/test_utils.hpp"
+
+#include <vpux_elf/utils/error.hpp>
+#include <vpux_headers/prelink_cache.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+struct LoadResult {
+    PatchedBuffers buffers;
+    MemoryUsage constructionUsage;
+};
+
+LoadResult loadBlob(const std::vector<uint8_t>& blob, const PrelinkCache* prelinkCache) {
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager, prelinkCache, utils::sha256(blob.data(), blob.size()));
+
+    LoadResult result;
+    result.constructionUsage = loader.getMemoryUsage();
+    TestIO io;
+    loadAndApplyIO(loader, io);
+    result.buffers = getPatchedBuffers(loader);
+    return result;
+}
+
+// A fresh cache directory makes sure that the first load of each blob validates its plan
+class CacheDirectory {
+public:
+    CacheDirectory() {
+        const auto uniqueSuffix = std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+        mPath = std::filesystem::temp_directory_path() / ("prelink_cache_test_" + uniqueSuffix);
+        std::filesystem::create_directories(mPath);
+    }
+
+    ~CacheDirectory() {
+        std::error_code error;
+        std::filesystem::remove_all(mPath, error);
+    }
+
+    const std::filesystem::path& getPath() const {
+        return mPath;
+    }
+
+    size_t countEntries() const {
+        return std::distance(std::filesystem::directory_iterator(mPath), std::filesystem::directory_iterator());
+    }
+
+private:
+    std::filesystem::path mPath;
+};
+
+bool testImportedPlan() {
+    const auto blob = buildTestBlob({/*packing=*/false});
+    CacheDirectory cacheDirectory;
+    const PrelinkCache prelinkCache(cacheDirectory.getPath().string(), "prelink_cache_test");
+
+    const auto validatedLoad = loadBlob(blob, &prelinkCache);
+    bool passed = check(cacheDirectory.countEntries() == 1, "the validated plan was not cached");
+    const auto importedLoad = loadBlob(blob, &prelinkCache);
+
+    // an imported plan doesn't read the relocation sections at construction
+    passed &= check(importedLoad.constructionUsage.sectionDataBytes < validatedLoad.constructionUsage.sectionDataBytes,
+                    "the relocation plan was not imported from the prelink cache");
+    passed &= check(importedLoad.buffers == validatedLoad.buffers,
+                    "imported and validated plans patch different bytes");
+    passed &= check(validatedLoad.buffers == loadBlob(blob, nullptr).buffers,
+                    "the prelink cache changes the bytes patched by a validated plan");
+    return passed;
+}
+
+bool testCorruptedEntry() {
+    const auto blob = buildTestBlob({/*packing=*/false});
+    CacheDirectory cacheDirectory;
+    const PrelinkCache prelinkCache(cacheDirectory.getPath().string(), "prelink_cache_test");
+    const auto validatedLoad = loadBlob(blob, &prelinkCache);
+
+    // flip the bytes at the end of every entry, where the runs of the plan are stored
+    for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory.getPath())) {
+        std::fstream file(entry.path(), std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-16, std::ios::end);
+        char bytes[16];
+        file.read(bytes, sizeof(bytes));
+        for (auto& byte : bytes) {
+            byte = static_cast<char>(~byte);
+        }
+        file.seekp(-16, std::ios::end);
+        file.write(bytes, sizeof(bytes));
+    }
+
+    const auto corruptedLoad = loadBlob(blob, &prelinkCache);
+    bool passed = check(corruptedLoad.constructionUsage.sectionDataBytes ==
+                                validatedLoad.constructionUsage.sectionDataBytes,
+                        "a corrupted entry was imported");
+    passed &= check(corruptedLoad.buffers == validatedLoad.buffers, "a corrupted entry changes the patched bytes");
+    return passed;
+}
+
+bool testPackedPlanNotCached() {
+    const auto blob = buildTestBlob({/*packing=*/true});
+    CacheDirectory cacheDirectory;
+    const PrelinkCache prelinkCache(cacheDirectory.getPath().string(), "prelink_cache_test");
+
+    // the plan of packed relocations is not smaller than them, reading it back would not save anything
+    const auto validatedLoad = loadBlob(blob, &prelinkCache);
+    bool passed = check(cacheDirectory.countEntries() == 0, "the plan of packed relocations was cached");
+    passed &= check(loadBlob(blob, &prelinkCache).buffers == validatedLoad.buffers,
+                    "the prelink cache changes the bytes patched by packed relocations");
+    return passed;
+}
+
+bool testDigestRequired() {
+    const auto blob = buildTestBlob({});
+    CacheDirectory cacheDirectory;
+    const PrelinkCache prelinkCache(cacheDirectory.getPath().string(), "prelink_cache_test");
+
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    try {
+        VPUXLoader loader(accessor.get(), &bufferManager, &prelinkCache);
+    } catch (const ArgsError&) {
+        return true;
+    }
+    return check(false, "a prelink cache without a blob digest was accepted");
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"imported plan", testImportedPlan},
+            {"corrupted entry", testCorruptedEntry},
+            {"packed plan not cached", testPackedPlanNotCached},
+            {"digest required", testDigestRequired},
+    });
+}
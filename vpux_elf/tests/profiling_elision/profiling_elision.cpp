@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// With profiling elision, a blob compiled with profiling runs without the profiling-only sections nor profiling
+// buffers, its profiling pointers referencing a dummy address
+
+#include "../common/test_utils.hpp"
+
+#include <algorithm>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+constexpr uint64_t PROFILING_DUMMY_ADDRESS = 0xDEAD0000;
+
+bool testProfiling() {
+    const auto blob = buildTestBlob({/*packing=*/true, /*loadSegments=*/false, /*profiling=*/true});
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    TestIO io(/*withProfiling=*/true);
+    loadAndApplyIO(loader, io);
+
+    const auto profiling = findBuffer(loader, PROFILING_SIZE);
+    bool passed = check(profiling.cpu_addr() != nullptr, "the profiling-only section was not loaded");
+    passed &= checkPatchSites(loader, io, profiling.vpu_addr(), io.profiling.front().vpu_addr());
+    passed &= check(loader.getProfBuffers().size() == 1, "the profiling output is not reported");
+    return passed;
+}
+
+bool testElision() {
+    const auto blob = buildTestBlob({/*packing=*/true, /*loadSegments=*/false, /*profiling=*/true});
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    loader.setProfilingElision(true, PROFILING_DUMMY_ADDRESS);
+    // the profiling buffers are ignored
+    TestIO io(/*withProfiling=*/true);
+    loadAndApplyIO(loader, io);
+
+    const auto allocatedSizes = bufferManager.getAllocatedSizes();
+    bool passed = check(std::find(allocatedSizes.begin(), allocatedSizes.end(), PROFILING_SIZE) == allocatedSizes.end(),
+                        "the profiling-only section was allocated");
+    passed &= checkPatchSites(loader, io, PROFILING_DUMMY_ADDRESS, PROFILING_DUMMY_ADDRESS);
+    passed &= check(loader.getProfBuffers().empty(), "profiling outputs are reported");
+
+    // the profiling pointers are patched at load, a copy of the loader keeps them
+    VPUXLoader copy(loader);
+    TestIO copyIO;
+    copy.applyJitRelocations(copyIO.inputs, copyIO.outputs, copyIO.profiling);
+    passed &= checkPatchSites(copy, copyIO, PROFILING_DUMMY_ADDRESS, PROFILING_DUMMY_ADDRESS);
+    passed &= check(bufferManager.getCalls().violations == 0, "the loader broke the BufferManager contract");
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"profiling", testProfiling},
+            {"elision", testElision},
+    });
+}
@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// Folding the runtime symbol table relocations ahead of time must drop them from the blob and leave the bytes patched
+// by the loader unchanged
+
+#include "../common/test_utils.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+struct BlobSummary {
+    size_t runtimeRelocationSections = 0;
+    size_t foldingNotes = 0;
+    uint32_t foldedCount = 0;
+};
+
+BlobSummary summarize(const std::vector<uint8_t>& blob) {
+    DDRAccessManager<DDRAlwaysEmplace> accessor(blob.data(), blob.size());
+    Reader<ELF_Bitness::Elf64> reader(&accessor);
+
+    BlobSummary summary;
+    for (size_t sectionIdx = 0; sectionIdx < reader.getSectionsNum(); ++sectionIdx) {
+        const auto section = reader.getSection(sectionIdx);
+        const auto header = section.getHeader();
+        if ((header->sh_type == SHT_RELA || header->sh_type == VPU_SHT_RELA_PACKED) &&
+            header->sh_link == VPU_RT_SYMTAB) {
+            ++summary.runtimeRelocationSections;
+        }
+        if (header->sh_type == SHT_NOTE) {
+            elf_note::VersionNote note{};
+            std::memcpy(&note, section.getData<uint8_t>(), sizeof(note));
+            if (note.n_type == elf_note::NT_NPU_RT_SYMTAB_FOLDED) {
+                ++summary.foldingNotes;
+                summary.foldedCount = note.n_desc[2];
+            }
+        }
+    }
+    return summary;
+}
+
+PatchedBuffers loadBlob(const std::vector<uint8_t>& blob) {
+    TestBufferManager bufferManager;
+    auto accessor = makeAccessManager(blob, &bufferManager);
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    TestIO io;
+    loadAndApplyIO(loader, io);
+    return getPatchedBuffers(loader);
+}
+
+bool testFolding(bool packing) {
+    const auto blob = buildTestBlob({packing});
+    const auto folded = VPUXLoader::foldRuntimeSymTabRelocations(blob.data(), blob.size(), getTestRuntimeSymbols(),
+                                                                 platform::ArchKind::VPUX37XX, 2);
+
+    const auto blobSummary = summarize(blob);
+    const auto foldedSummary = summarize(folded);
+    bool passed = check(blobSummary.runtimeRelocationSections == 1, "the test blob has no runtime relocation");
+    passed &= check(foldedSummary.runtimeRelocationSections == 0, "runtime relocations were left in the blob");
+    passed &= check(foldedSummary.foldingNotes == 1 && foldedSummary.foldedCount == MI_RUNTIME_SITES_COUNT,
+                    "the folded blob doesn't record the folding");
+    passed &= check(loadBlob(folded) == loadBlob(blob), "folding changes the bytes patched by the loader");
+    return passed;
+}
+
+// folding .rela.rt would apply its patches before the ones of .rela.mi patching the same sites
+bool testOverlappingNotFolded() {
+    auto overlapping = buildTestBlob({/*packing=*/false});
+    // move the first site of .rela.mi onto the first runtime site
+    DDRAccessManager<DDRAlwaysEmplace> accessor(overlapping.data(), overlapping.size());
+    Reader<ELF_Bitness::Elf64> reader(&accessor);
+    for (size_t sectionIdx = 0; sectionIdx < reader.getSectionsNum(); ++sectionIdx) {
+        const auto section = reader.getSection(sectionIdx);
+        if (std::string(section.getName()) == ".rela.mi") {
+            const Elf64_Addr offset = MI_RUNTIME_SITES_OFFSET;
+            std::memcpy(overlapping.data() + section.getHeader()->sh_offset + offsetof(Elf64_Rela, r_offset), &offset,
+                        sizeof(offset));
+        }
+    }
+
+    const auto folded = VPUXLoader::foldRuntimeSymTabRelocations(
+            overlapping.data(), overlapping.size(), getTestRuntimeSymbols(), platform::ArchKind::VPUX37XX, 2);
+    return check(folded == overlapping, "runtime relocations overlapping other patches were folded");
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"plain", std::bind(testFolding, false)},
+            {"packed", std::bind(testFolding, true)},
+            {"overlapping not folded", testOverlappingNotFolded},
+    });
+}
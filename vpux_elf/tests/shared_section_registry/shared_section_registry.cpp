@@ -0,0 +1,101 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// With shared section deduplication, loaders of different blobs with byte-identical read-only sections map them to a
+// single device buffer, which lives as long as the last of them
+
+#include "../common/test_utils.hpp"
+
+#include <vpux_headers/shared_section_registry.hpp>
+
+#include <memory>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+std::unique_ptr<VPUXLoader> loadBlob(const std::vector<uint8_t>& blob, TestBufferManager& bufferManager,
+                                     std::shared_ptr<AccessManager>& accessor, bool deduplication) {
+    accessor = makeAccessManager(blob, &bufferManager);
+    auto loader = std::make_unique<VPUXLoader>(accessor.get(), &bufferManager);
+    loader->setSharedSectionDeduplication(deduplication);
+    TestIO io;
+    loadAndApplyIO(*loader, io);
+    return loader;
+}
+
+bool testDeduplication() {
+    auto& registry = SharedSectionRegistry::getInstance();
+    const auto initialStats = registry.getStats();
+
+    // the two blobs only differ by their relocation encoding
+    const auto firstBlob = buildTestBlob({/*packing=*/true});
+    const auto secondBlob = buildTestBlob({/*packing=*/false});
+    TestBufferManager bufferManager;
+    bool passed = true;
+    {
+        std::shared_ptr<AccessManager> firstAccessor;
+        std::shared_ptr<AccessManager> secondAccessor;
+        auto first = loadBlob(firstBlob, bufferManager, firstAccessor, true);
+        const auto allocations = bufferManager.getCalls().allocate;
+        auto second = loadBlob(secondBlob, bufferManager, secondAccessor, true);
+
+        const auto stats = registry.getStats();
+        TestIO io;
+        passed &= checkPatchSites(*first, io) && checkPatchSites(*second, io);
+        passed &= check(findBuffer(*first, WEIGHTS_SIZE).vpu_addr() == findBuffer(*second, WEIGHTS_SIZE).vpu_addr(),
+                        "identical read-only sections got different buffers");
+        passed &= check(bufferManager.getCalls().allocate - allocations == allocations - 1,
+                        "the shared section was allocated again");
+        passed &= check(stats.hits == initialStats.hits + 1 && stats.liveBuffers == initialStats.liveBuffers + 1,
+                        "the registry doesn't report the shared section");
+
+        // the buffer outlives the loader which registered it
+        first.reset();
+        passed &= check(bufferManager.isLive(findBuffer(*second, WEIGHTS_SIZE)), "the shared buffer was released");
+        passed &= checkPatchSites(*second, io);
+    }
+    passed &= check(bufferManager.getLiveBuffersCount() == 0, "the shared buffer was not released");
+    passed &= check(registry.getStats().liveBuffers == initialStats.liveBuffers,
+                    "the registry keeps a released buffer alive");
+    return passed;
+}
+
+bool testDistinctSections() {
+    const auto blob = buildTestBlob({});
+    auto otherWeightsOptions = TestBlobOptions();
+    otherWeightsOptions.weightsValue = 0x33;
+    const auto otherWeightsBlob = buildTestBlob(otherWeightsOptions);
+
+    TestBufferManager bufferManager;
+    TestBufferManager otherBufferManager;
+    std::shared_ptr<AccessManager> accessors[4];
+    auto loader = loadBlob(blob, bufferManager, accessors[0], true);
+    // different bytes, different BufferManager, deduplication disabled
+    auto otherWeights = loadBlob(otherWeightsBlob, bufferManager, accessors[1], true);
+    auto otherManager = loadBlob(blob, otherBufferManager, accessors[2], true);
+    auto disabled = loadBlob(blob, bufferManager, accessors[3], false);
+
+    const auto weightsAddress = findBuffer(*loader, WEIGHTS_SIZE).vpu_addr();
+    bool passed = check(findBuffer(*otherWeights, WEIGHTS_SIZE).vpu_addr() != weightsAddress,
+                        "different read-only sections share a buffer");
+    passed &= check(findBuffer(*otherManager, WEIGHTS_SIZE).cpu_addr() != findBuffer(*loader, WEIGHTS_SIZE).cpu_addr(),
+                    "loaders of different BufferManagers share a buffer");
+    passed &= check(findBuffer(*disabled, WEIGHTS_SIZE).vpu_addr() != weightsAddress,
+                    "a loader without deduplication shares a buffer");
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"deduplication", testDeduplication},
+            {"distinct sections", testDistinctSections},
+    });
+}
@@ -0,0 +1,112 @@
+//
+// Copyright (C) 2023 Intel Corporation
+// SPDX-License-Identifier: Apache 2.0
+//
+
+//
+
+// Large shared sections streamed in chunks must reach the device buffers unchanged, without being read as a whole
+
+#include "../common/test_utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+
+using namespace elf;
+using namespace elf::test;
+
+namespace {
+
+constexpr size_t CHUNK_SIZE = 256;
+
+struct LoadResult {
+    std::vector<uint8_t> weights;
+    size_t copyAtCalls = 0;
+    bool patchSitesPassed = false;
+};
+
+LoadResult loadBlob(const std::shared_ptr<AccessManager>& accessor, TestBufferManager& bufferManager,
+                    bool streaming) {
+    VPUXLoader loader(accessor.get(), &bufferManager);
+    loader.setStreamingUpload(streaming, CHUNK_SIZE);
+    TestIO io;
+    loadAndApplyIO(loader, io);
+
+    LoadResult result;
+    const auto weights = findBuffer(loader, WEIGHTS_SIZE);
+    result.weights.assign(weights.cpu_addr(), weights.cpu_addr() + weights.size());
+    result.copyAtCalls = bufferManager.getCalls().copyAt;
+    result.patchSitesPassed = checkPatchSites(loader, io);
+    return result;
+}
+
+bool testDDR() {
+    const auto blob = buildTestBlob({});
+    TestBufferManager bufferManager;
+    TestBufferManager streamingBufferManager;
+    const auto whole = loadBlob(makeAccessManager(blob, &bufferManager), bufferManager, false);
+    const auto streamed = loadBlob(makeAccessManager(blob, &streamingBufferManager), streamingBufferManager, true);
+
+    bool passed = check(whole.patchSitesPassed && streamed.patchSitesPassed, "wrong patch sites");
+    passed &= check(streamed.weights == whole.weights &&
+                            std::count(streamed.weights.begin(), streamed.weights.end(), 0x5A) ==
+                                    static_cast<std::ptrdiff_t>(WEIGHTS_SIZE),
+                    "the streamed section changed");
+    passed &= check(whole.copyAtCalls == 0 &&
+                            streamed.copyAtCalls == (WEIGHTS_SIZE + CHUNK_SIZE - 1) / CHUNK_SIZE,
+                    "the section was not uploaded chunk by chunk");
+    passed &= check(streamingBufferManager.getCalls().violations == 0, "streaming broke the BufferManager contract");
+    return passed;
+}
+
+bool testFS() {
+    const auto blob = buildTestBlob({});
+    const auto uniqueSuffix = std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    const auto blobPath = std::filesystem::temp_directory_path() / ("streaming_upload_" + uniqueSuffix + ".elf");
+    {
+        std::ofstream blobFile(blobPath, std::ios::binary);
+        blobFile.write(reinterpret_cast<const char*>(blob.data()), blob.size());
+    }
+
+    bool passed = true;
+    {
+        // the sections are read into host buffers, then uploaded
+        TestBufferManager bufferManager;
+        TestBufferManager streamingBufferManager;
+        RecordingHostAllocator hostAllocator;
+        RecordingHostAllocator streamingHostAllocator;
+        const auto makeFSAccessManager = [&blobPath](const RecordingHostAllocator& allocator) {
+            return std::make_shared<FSAccessManager<>>(
+                    blobPath.string(), std::make_shared<DynamicBufferFactory>(allocator.getAllocator()));
+        };
+        const auto whole = loadBlob(makeFSAccessManager(hostAllocator), bufferManager, false);
+        const auto streamed = loadBlob(makeFSAccessManager(streamingHostAllocator), streamingBufferManager, true);
+
+        passed &= check(whole.patchSitesPassed && streamed.patchSitesPassed, "wrong patch sites");
+        passed &= check(streamed.weights == whole.weights, "the streamed section changed");
+        passed &= check(streamed.copyAtCalls == (WEIGHTS_SIZE + CHUNK_SIZE - 1) / CHUNK_SIZE,
+                        "the section was not uploaded chunk by chunk");
+        // the streamed section is never held as a whole in host memory
+        const auto weightsAllocationSize = DynamicBuffer::getAllocationSize(WEIGHTS_SIZE);
+        passed &= check(hostAllocator.hasAllocated(weightsAllocationSize) &&
+                                !streamingHostAllocator.hasAllocated(weightsAllocationSize),
+                        "the streamed section was read as a whole");
+        passed &= check(streamingBufferManager.getCalls().violations == 0,
+                        "streaming broke the BufferManager contract");
+    }
+    std::filesystem::remove(blobPath);
+    return passed;
+}
+
+}  // namespace
+
+int main() {
+    return runTests({
+            {"DDR", testDDR},
+            {"FS", testFS},
+    });
+}